@@ -0,0 +1,204 @@
+#include "Benchmark.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+using namespace Mutang;
+using namespace llvm;
+
+static std::vector<std::pair<std::string, BenchmarkFunction>> &registry() {
+  static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+  return benchmarks;
+}
+
+BenchmarkRegistration::BenchmarkRegistration(const char *name,
+                                             BenchmarkFunction function) {
+  registry().push_back(std::make_pair(name, function));
+}
+
+BenchmarkState::BenchmarkState(uint64_t iterations)
+  : iterations(iterations), completed(0), itemsProcessed(0), paused(0),
+    elapsed(0), running(false)
+{
+}
+
+bool BenchmarkState::keepRunning() {
+  if (!running) {
+    running = true;
+    start = Clock::now();
+  }
+
+  if (completed < iterations && error.empty()) {
+    completed++;
+    return true;
+  }
+
+  elapsed = Clock::now() - start - paused;
+  return false;
+}
+
+void BenchmarkState::pauseTiming() {
+  pausedAt = Clock::now();
+}
+
+void BenchmarkState::resumeTiming() {
+  paused += Clock::now() - pausedAt;
+}
+
+double BenchmarkState::getElapsedNanoseconds() const {
+  return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+std::vector<BenchmarkResult> Mutang::runBenchmarks(const std::string &filter,
+                                                   double minimumTime) {
+  const double minimumNanoseconds = minimumTime * 1e9;
+
+  std::vector<BenchmarkResult> results;
+  for (auto &benchmark : registry()) {
+    if (benchmark.first.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    uint64_t iterations = 1;
+    while (true) {
+      BenchmarkState state(iterations);
+      auto start = std::chrono::steady_clock::now();
+      benchmark.second(state);
+      auto wallTime = std::chrono::steady_clock::now() - start;
+
+      if (!state.getError().empty()) {
+        results.push_back({ benchmark.first, iterations, 0, 0, state.getError() });
+        break;
+      }
+
+      /// Paused time counts against the wall time, or benchmarks that spend
+      /// most of it in the setup would run forever
+      const double elapsed = state.getElapsedNanoseconds();
+      const double wallNanoseconds =
+        std::chrono::duration<double, std::nano>(wallTime).count();
+      if (elapsed >= minimumNanoseconds ||
+          wallNanoseconds >= minimumNanoseconds * 10 ||
+          iterations >= (1ULL << 30)) {
+        const double itemsPerSecond =
+          elapsed > 0 ? state.getItemsProcessed() * 1e9 / elapsed : 0;
+        results.push_back({ benchmark.first, iterations, elapsed / iterations,
+                            itemsPerSecond });
+        break;
+      }
+
+      /// Aim a bit past the minimum time, but grow at most tenfold at once
+      const double perIteration = std::max(elapsed / iterations, 1.0);
+      const double next = minimumNanoseconds * 1.4 / perIteration;
+      iterations = std::max<uint64_t>(iterations + 1,
+                                      std::min<uint64_t>(next, iterations * 10));
+    }
+
+    const BenchmarkResult &result = results.back();
+    if (!result.error.empty()) {
+      outs() << format("%-48s ", result.name.c_str())
+             << "ERROR: " << result.error << "\n";
+      outs().flush();
+      continue;
+    }
+
+    outs() << format("%-48s %14.0f ns %12llu",
+                     result.name.c_str(),
+                     result.nanosecondsPerIteration,
+                     (unsigned long long)result.iterations);
+    if (result.itemsPerSecond > 0) {
+      outs() << format(" %14.1f items/s", result.itemsPerSecond);
+    }
+    outs() << "\n";
+    outs().flush();
+  }
+  return results;
+}
+
+bool Mutang::writeBenchmarkResults(const std::vector<BenchmarkResult> &results,
+                                   const std::string &path) {
+  std::error_code EC;
+  raw_fd_ostream out(path, EC, sys::fs::F_Text);
+  if (EC) {
+    return false;
+  }
+
+  out << "{\n  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult &result = results[i];
+    out << "    {\"name\": \"" << result.name << "\", ";
+    if (!result.error.empty()) {
+      out << "\"error_occurred\": true, "
+          << "\"error_message\": \"";
+      out.write_escaped(result.error);
+      out << "\", ";
+    }
+    out << "\"iterations\": " << result.iterations << ", "
+        << "\"real_time\": " << format("%.1f", result.nanosecondsPerIteration) << ", ";
+    if (result.itemsPerSecond > 0) {
+      out << "\"items_per_second\": " << format("%.1f", result.itemsPerSecond) << ", ";
+    }
+    out << "\"time_unit\": \"ns\"}"
+        << (i + 1 == results.size() ? "\n" : ",\n");
+  }
+  out << "  ]\n}\n";
+
+  out.close();
+  if (out.has_error()) {
+    out.clear_error();
+    return false;
+  }
+  return true;
+}
+
+static cl::opt<std::string> Filter(
+    "filter",
+    cl::desc("Run only the benchmarks whose name contains the string."),
+    cl::init("")
+);
+
+static cl::opt<double> MinimumTime(
+    "min-time",
+    cl::desc("Minimum time of a benchmark run in seconds."),
+    cl::init(0.5)
+);
+
+static cl::opt<std::string> JSONOutput(
+    "json",
+    cl::desc("Write the results as JSON to the file."),
+    cl::init("")
+);
+
+int main(int argc, char *argv[]) {
+  cl::ParseCommandLineOptions(argc, argv, "Mutang benchmarks");
+
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  outs() << format("%-48s %17s %12s\n",
+                   (const char *)"Benchmark",
+                   (const char *)"Time",
+                   (const char *)"Iterations");
+
+  auto results = runBenchmarks(Filter, MinimumTime);
+
+  if (!JSONOutput.empty() && !writeBenchmarkResults(results, JSONOutput)) {
+    errs() << "Cannot write results to " << JSONOutput << "\n";
+    return EXIT_FAILURE;
+  }
+
+  for (auto &result : results) {
+    if (!result.error.empty()) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
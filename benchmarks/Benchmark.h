@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Mutang {
+
+  /// Iterations of a benchmark, the body runs as long as keepRunning says so:
+  ///
+  ///   MUTANG_BENCHMARK(Compiler_compileModule) {
+  ///     ... setup ...
+  ///     while (state.keepRunning()) {
+  ///       ... measured code ...
+  ///     }
+  ///   }
+  ///
+  /// Work that must happen in each iteration but should not be measured,
+  /// such as creating a fresh input, goes between pauseTiming and
+  /// resumeTiming.
+  class BenchmarkState {
+    typedef std::chrono::steady_clock Clock;
+
+    uint64_t iterations;
+    uint64_t completed;
+    uint64_t itemsProcessed;
+    Clock::time_point start;
+    Clock::time_point pausedAt;
+    Clock::duration paused;
+    Clock::duration elapsed;
+    bool running;
+    std::string error;
+
+  public:
+    explicit BenchmarkState(uint64_t iterations);
+
+    bool keepRunning();
+
+    void pauseTiming();
+    void resumeTiming();
+
+    uint64_t getIterations() const { return iterations; }
+
+    /// Work done by all the iterations, such as mutants run, reported
+    /// as a rate over the measured time
+    void setItemsProcessed(uint64_t items) { itemsProcessed = items; }
+    uint64_t getItemsProcessed() const { return itemsProcessed; }
+
+    /// Measured time of all the iterations, without the paused time
+    double getElapsedNanoseconds() const;
+
+    /// Stops the benchmark and fails the whole run, e.g. when the measured
+    /// code did not do the work it is measured for
+    void setError(const std::string &message) { error = message; }
+    const std::string &getError() const { return error; }
+  };
+
+  typedef std::function<void (BenchmarkState &)> BenchmarkFunction;
+
+  struct BenchmarkRegistration {
+    BenchmarkRegistration(const char *name, BenchmarkFunction function);
+  };
+
+  struct BenchmarkResult {
+    std::string name;
+    uint64_t iterations;
+    double nanosecondsPerIteration;
+    /// Zero unless the benchmark sets the items processed
+    double itemsPerSecond;
+    /// Empty unless the benchmark failed
+    std::string error;
+  };
+
+  /// Runs every benchmark whose name contains the filter with more and more
+  /// iterations until one run takes at least minimumTime seconds
+  std::vector<BenchmarkResult> runBenchmarks(const std::string &filter,
+                                             double minimumTime);
+
+  /// Same layout as the JSON output of Google Benchmark, so that the
+  /// existing tools for comparing runs can read it
+  bool writeBenchmarkResults(const std::vector<BenchmarkResult> &results,
+                             const std::string &path);
+}
+
+#define MUTANG_BENCHMARK(name)                                               \
+  static void name(Mutang::BenchmarkState &state);                           \
+  static Mutang::BenchmarkRegistration name##_registration(#name, name);     \
+  static void name(Mutang::BenchmarkState &state)
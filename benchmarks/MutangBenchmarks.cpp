@@ -0,0 +1,235 @@
+#include "Benchmark.h"
+
+#include "Context.h"
+#include "ForkProcessSandbox.h"
+#include "ModuleLoader.h"
+#include "MutangModule.h"
+#include "MutationPoint.h"
+#include "Result.h"
+#include "SQLiteReporter.h"
+#include "TestModuleFactory.h"
+#include "TestResult.h"
+
+#include "MutationOperators/AddMutationOperator.h"
+#include "MutationOperators/MutationOperatorFilter.h"
+#include "MutationOperators/MutationPointScanner.h"
+#include "MutationOperators/NegateConditionMutationOperator.h"
+#include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "Toolchain/Compiler.h"
+#include "Toolchain/ObjectCache.h"
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/IR/LLVMContext.h"
+
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static std::unique_ptr<TargetMachine> createTargetMachine() {
+  return std::unique_ptr<TargetMachine>(
+    EngineBuilder().selectTarget(Triple(), "", "", SmallVector<std::string, 1>()));
+}
+
+static std::vector<std::unique_ptr<MutationOperator>> allMutationOperators() {
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+  mutationOperators.emplace_back(make_unique<RemoveVoidFunctionMutationOperator>());
+  return mutationOperators;
+}
+
+/// The tester and testee modules of the SimpleTest fixtures
+static std::unique_ptr<Context> createContext() {
+  auto context = make_unique<Context>();
+  context->addModule(make_unique<MutangModule>(TestModuleFactory.createTesterModule(), ""));
+  context->addModule(make_unique<MutangModule>(TestModuleFactory.createTesteeModule(), ""));
+  return context;
+}
+
+MUTANG_BENCHMARK(ModuleLoader_loadModuleAtPath) {
+  LLVMContext llvmContext;
+  ModuleLoader loader(llvmContext);
+  const std::string path = TestModuleFactory.testerModulePath_Bitcode();
+
+  while (state.keepRunning()) {
+    auto module = loader.loadModuleAtPath(path);
+  }
+}
+
+MUTANG_BENCHMARK(Context_addModule) {
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    auto context = make_unique<Context>();
+    auto module = make_unique<MutangModule>(TestModuleFactory.createTesterModule(), "");
+    state.resumeTiming();
+
+    context->addModule(std::move(module));
+
+    state.pauseTiming();
+    context.reset();
+    state.resumeTiming();
+  }
+}
+
+MUTANG_BENCHMARK(SimpleTestFinder_findTestees) {
+  auto context = createContext();
+  SimpleTestFinder finder(allMutationOperators());
+  auto tests = finder.findTests(*context);
+
+  while (state.keepRunning()) {
+    auto testees = finder.findTestees(tests.front().get(), *context, 4);
+  }
+}
+
+/// The finder caches the points of each function, the scanner behind it
+/// walks the function on every call
+MUTANG_BENCHMARK(MutationPointScanner_scan) {
+  auto context = createContext();
+  SimpleTestFinder finder(allMutationOperators());
+  auto tests = finder.findTests(*context);
+  auto testees = finder.findTestees(tests.front().get(), *context, 4);
+  Function *testee = testees.back()->getTesteeFunction();
+
+  auto mutationOperators = allMutationOperators();
+  MutationPointScanner scanner(mutationOperators);
+  NullMutationOperatorFilter filter;
+
+  while (state.keepRunning()) {
+    auto mutationPoints = scanner.scan(*context, *testee, filter);
+  }
+}
+
+MUTANG_BENCHMARK(Compiler_compileModule) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  MutangModule module(TestModuleFactory.createTesteeModule(), "");
+
+  while (state.keepRunning()) {
+    auto object = compiler.compileModule(module);
+  }
+}
+
+MUTANG_BENCHMARK(ObjectCache_getObject_Memory) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  MutangModule module(TestModuleFactory.createTesteeModule(), "");
+
+  ObjectCache cache(false, "/tmp/mutang_benchmark_cache");
+  cache.putObject(compiler.compileModule(module), "testee");
+
+  while (state.keepRunning()) {
+    cache.getObject("testee");
+  }
+}
+
+MUTANG_BENCHMARK(ObjectCache_getObject_Disk) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  MutangModule module(TestModuleFactory.createTesteeModule(), "");
+
+  {
+    ObjectCache cache(true, "/tmp/mutang_benchmark_cache");
+    cache.putObject(compiler.compileModule(module), "testee");
+  }
+
+  /// A fresh cache has nothing in memory and reads the object from disk
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    auto cache = make_unique<ObjectCache>(true, "/tmp/mutang_benchmark_cache");
+    state.resumeTiming();
+
+    cache->getObject("testee");
+
+    state.pauseTiming();
+    cache.reset();
+    state.resumeTiming();
+  }
+}
+
+MUTANG_BENCHMARK(ObjectCache_putObject_Disk) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  MutangModule module(TestModuleFactory.createTesteeModule(), "");
+  ObjectCache cache(true, "/tmp/mutang_benchmark_cache");
+
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    auto object = compiler.compileModule(module);
+    state.resumeTiming();
+
+    cache.putObject(std::move(object), "testee");
+  }
+}
+
+MUTANG_BENCHMARK(ForkProcessSandbox_run) {
+  ForkProcessSandbox sandbox;
+
+  while (state.keepRunning()) {
+    sandbox.run([&](ExecutionResult *SharedResult) {
+      ExecutionResult R;
+      R.Status = Passed;
+      R.RunningTime = 0;
+      *SharedResult = R;
+    }, 1000);
+  }
+}
+
+MUTANG_BENCHMARK(NullProcessSandbox_run) {
+  NullProcessSandbox sandbox;
+
+  while (state.keepRunning()) {
+    sandbox.run([&](ExecutionResult *SharedResult) {
+      ExecutionResult R;
+      R.Status = Passed;
+      R.RunningTime = 0;
+      *SharedResult = R;
+    }, 1000);
+  }
+}
+
+/// Every mutant of the fixtures is reported as run against the test
+/// a hundred times
+MUTANG_BENCHMARK(SQLiteReporter_reportResults) {
+  auto context = createContext();
+  SimpleTestFinder finder(allMutationOperators());
+  SQLiteReporter reporter;
+
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    auto tests = finder.findTests(*context);
+    auto testees = finder.findTestees(tests.front().get(), *context, 4);
+
+    ExecutionResult executionResult;
+    executionResult.Status = Passed;
+    executionResult.RunningTime = 1000;
+    executionResult.stdoutOutput = "stdout";
+    executionResult.stderrOutput = "stderr";
+
+    auto testResult = make_unique<TestResult>(executionResult, std::move(tests.front()));
+    for (auto testee : testees) {
+      auto mutationPoints = finder.findMutationPoints(*context, *testee->getTesteeFunction());
+      for (auto mutationPoint : mutationPoints) {
+        for (int i = 0; i < 100; i++) {
+          testResult->addMutantResult(make_unique<MutationResult>(executionResult,
+                                                                  mutationPoint,
+                                                                  testee));
+        }
+      }
+    }
+
+    std::vector<std::unique_ptr<TestResult>> testResults;
+    testResults.push_back(std::move(testResult));
+    auto result = make_unique<Result>(std::move(testResults), std::move(testees));
+    state.resumeTiming();
+
+    reporter.reportResults(result);
+
+    state.pauseTiming();
+    unlink(reporter.getDatabasePath().c_str());
+    state.resumeTiming();
+  }
+}
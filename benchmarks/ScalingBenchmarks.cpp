@@ -0,0 +1,113 @@
+#include "Benchmark.h"
+
+#include "Config.h"
+#include "Driver.h"
+#include "Logger.h"
+#include "ModuleLoader.h"
+#include "Result.h"
+#include "TestResult.h"
+#include "SyntheticProject.h"
+
+#include "MutationOperators/MutationOperatorRegistry.h"
+#include "SimpleTest/SimpleTestFinder.h"
+#include "SimpleTest/SimpleTestRunner.h"
+#include "Toolchain/Toolchain.h"
+
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+using namespace Mutang;
+using namespace llvm;
+
+/// Writes the SimpleTest modules of the project as bitcode files
+static std::vector<std::string> writeSyntheticProject(const std::string &name,
+                                                      const SyntheticProject &project) {
+  const std::string directory = "/tmp/mutang_benchmark_synthetic/" + name;
+  sys::fs::create_directories(directory);
+
+  LLVMContext context;
+  std::vector<std::string> paths;
+  for (auto &module : project.createSimpleTestModules(context)) {
+    const std::string path = directory + "/" + module->getModuleIdentifier() + ".bc";
+
+    std::error_code EC;
+    raw_fd_ostream out(path, EC, sys::fs::F_None);
+    assert(!EC && "Can't write synthetic module");
+    WriteBitcodeToFile(module.get(), out);
+    paths.push_back(path);
+  }
+  return paths;
+}
+
+/// Loads, finds and runs everything the way the driver does, without
+/// the object cache so that every iteration compiles the mutants again.
+/// The throughput is the rate of mutant runs, in mutants per second.
+static void runSyntheticProject(BenchmarkState &state,
+                                const std::string &name,
+                                const SyntheticProjectOptions &options) {
+  SyntheticProject project(options);
+  auto paths = writeSyntheticProject(name, project);
+
+  Config config(paths, true, false, false, MutangDefaultTimeout, 128,
+                "/tmp/mutang_benchmark_cache");
+  MutationOperatorRegistry registry;
+
+  Logger::setLevel(Logger::Level::error);
+
+  uint64_t mutants = 0;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    /// The toolchain keeps compiled objects in memory, a new one compiles
+    /// everything again
+    Toolchain toolchain(config);
+    LLVMContext context;
+    ModuleLoader loader(context);
+    SimpleTestFinder finder(registry.createOperators(config.getMutationOperators()));
+    SimpleTestRunner runner(toolchain.targetMachine());
+    Driver driver(config, loader, finder, runner, toolchain);
+    state.resumeTiming();
+
+    auto result = driver.Run();
+
+    state.pauseTiming();
+    for (auto &testResult : result->getTestResults()) {
+      /// Mutants of a project whose own tests fail measure nothing
+      if (testResult->getOriginalTestResult().Status != ExecutionStatus::Passed) {
+        state.setError("original test " + testResult->getTestName() + " did not pass");
+      }
+      mutants += testResult->getMutationResults().size();
+    }
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(mutants);
+}
+
+/// More modules with the same shape of each of them
+MUTANG_BENCHMARK(Driver_Run_Synthetic_Modules_1) {
+  runSyntheticProject(state, "modules_1", { 1, 3, 2, 2 });
+}
+
+MUTANG_BENCHMARK(Driver_Run_Synthetic_Modules_4) {
+  runSyntheticProject(state, "modules_4", { 4, 3, 2, 2 });
+}
+
+MUTANG_BENCHMARK(Driver_Run_Synthetic_Modules_16) {
+  runSyntheticProject(state, "modules_16", { 16, 3, 2, 2 });
+}
+
+/// Deeper call graphs, each test reaches more of the project
+MUTANG_BENCHMARK(Driver_Run_Synthetic_Depth_6) {
+  runSyntheticProject(state, "depth_6", { 4, 6, 2, 2 });
+}
+
+/// More mutation sites per function
+MUTANG_BENCHMARK(Driver_Run_Synthetic_Density_8) {
+  runSyntheticProject(state, "density_8", { 4, 3, 2, 8 });
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "TestResult.h"
+
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+
+namespace Mutang {
+
+/// Results of a previous run, used to run only the mutants affected by
+/// a change.
+///
+/// A result is reused when the test has the same name and reaches exactly
+/// the same code (see FunctionHasher::hashReachableCode) and the mutation
+/// point has the same stable identifier (see FunctionHasher::stableIdentifier).
+class Baseline {
+  llvm::StringMap<ExecutionResult> results;
+
+  static std::string key(const std::string &testName,
+                         const std::string &testeesHash,
+                         const std::string &mutationPointIdentifier);
+
+public:
+  /// Reads the database written by SQLiteReporter, returns false if it
+  /// cannot be read or is too old to have the hashes
+  bool load(const std::string &databasePath);
+
+  const ExecutionResult *findResult(const std::string &testName,
+                                    const std::string &testeesHash,
+                                    const std::string &mutationPointIdentifier) const;
+
+  size_t size() const {
+    return results.size();
+  }
+};
+
+}
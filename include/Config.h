@@ -6,6 +6,11 @@
 #include <vector>
 
 static int MutangDefaultTimeout = 3000;
+static double MutangDefaultTimeoutMultiplier = 10;
+static int MutangDefaultMinimumTimeout = 300;
+static int MutangDefaultMaximumTimeout = 60000;
+static int MutangDefaultTimingSamples = 1;
+static int MutangDefaultLoopBudgetMultiplier = 10;
 
 // We need these forward declarations to make our config friends with the
 // mapping traits.
@@ -28,6 +33,32 @@ class Config {
   int timeout;
   int maxDistance;
   std::string cacheDirectory;
+  bool emitDebugInfo;
+  bool zygote;
+  bool mutantCentric;
+  bool coveragePruning;
+  double timeoutMultiplier;
+  int minimumTimeout;
+  int maximumTimeout;
+  int timingSamples;
+  bool loopBudget;
+  int loopBudgetMultiplier;
+  bool equivalentMutantPruning;
+  bool trivialCompilerEquivalence;
+  std::vector<std::string> mutationOperators;
+  std::vector<std::string> includeLocations;
+  std::vector<std::string> excludeLocations;
+  std::vector<std::string> includeFunctions;
+  std::vector<std::string> excludeFunctions;
+  std::string baselineDatabase;
+  int shardIndex;
+  int shardCount;
+  int workers;
+  std::string workerSocket;
+  std::string workerCommand;
+  std::string traceFile;
+  int memoryLimit;
+  int cpuLimit;
 
   friend llvm::yaml::MappingTraits<Mutang::Config>;
 public:
@@ -40,7 +71,33 @@ public:
     useCache(true),
     timeout(MutangDefaultTimeout),
     maxDistance(128),
-    cacheDirectory("/tmp/mutang_cache")
+    cacheDirectory("/tmp/mutang_cache"),
+    emitDebugInfo(true),
+    zygote(false),
+    mutantCentric(false),
+    coveragePruning(false),
+    timeoutMultiplier(MutangDefaultTimeoutMultiplier),
+    minimumTimeout(MutangDefaultMinimumTimeout),
+    maximumTimeout(MutangDefaultMaximumTimeout),
+    timingSamples(MutangDefaultTimingSamples),
+    loopBudget(false),
+    loopBudgetMultiplier(MutangDefaultLoopBudgetMultiplier),
+    equivalentMutantPruning(false),
+    trivialCompilerEquivalence(false),
+    mutationOperators(),
+    includeLocations(),
+    excludeLocations(),
+    includeFunctions(),
+    excludeFunctions(),
+    baselineDatabase(),
+    shardIndex(0),
+    shardCount(1),
+    workers(0),
+    workerSocket(),
+    workerCommand(),
+    traceFile(),
+    memoryLimit(0),
+    cpuLimit(0)
   {
   }
 
@@ -57,7 +114,33 @@ public:
     useCache(cache),
     timeout(timeout),
     maxDistance(distance),
-    cacheDirectory(cacheDir)
+    cacheDirectory(cacheDir),
+    emitDebugInfo(true),
+    zygote(false),
+    mutantCentric(false),
+    coveragePruning(false),
+    timeoutMultiplier(MutangDefaultTimeoutMultiplier),
+    minimumTimeout(MutangDefaultMinimumTimeout),
+    maximumTimeout(MutangDefaultMaximumTimeout),
+    timingSamples(MutangDefaultTimingSamples),
+    loopBudget(false),
+    loopBudgetMultiplier(MutangDefaultLoopBudgetMultiplier),
+    equivalentMutantPruning(false),
+    trivialCompilerEquivalence(false),
+    mutationOperators(),
+    includeLocations(),
+    excludeLocations(),
+    includeFunctions(),
+    excludeFunctions(),
+    baselineDatabase(),
+    shardIndex(0),
+    shardCount(1),
+    workers(0),
+    workerSocket(),
+    workerCommand(),
+    traceFile(),
+    memoryLimit(0),
+    cpuLimit(0)
   {
   }
 
@@ -89,6 +172,152 @@ public:
     return cacheDirectory;
   }
 
+  bool shouldEmitDebugInfo() const {
+    return emitDebugInfo;
+  }
+
+  /// Run global initialization once in the parent process and fork every
+  /// test from the initialized state. Only takes effect together with fork.
+  /// Mutant runs change the program and initialize it again, and so do the
+  /// original runs when coverage_pruning or loop_budget instrument it.
+  bool getZygote() const {
+    return zygote;
+  }
+
+  /// Run each mutant against all the tests reaching it, most likely killers
+  /// first, and stop at the first test that kills it.
+  bool isMutantCentric() const {
+    return mutantCentric;
+  }
+
+  /// Run tests against an instrumented program first and do not run
+  /// mutants in basic blocks the test never executed.
+  bool isCoveragePruningEnabled() const {
+    return coveragePruning;
+  }
+
+  /// Mutant timeouts, see TimeoutPolicy. Bounds are in milliseconds.
+  double getTimeoutMultiplier() const {
+    return timeoutMultiplier;
+  }
+
+  int getMinimumTimeout() const {
+    return minimumTimeout;
+  }
+
+  int getMaximumTimeout() const {
+    return maximumTimeout;
+  }
+
+  /// How many times each original test runs to measure its running time.
+  /// Every extra sample is one more run of each test, so it defaults to one.
+  int getTimingSamples() const {
+    return timingSamples;
+  }
+
+  /// End mutants whose loops run much longer than in the original test
+  /// instead of waiting for the timeout, see LoopBudget. Requires fork.
+  bool isLoopBudgetEnabled() const {
+    return loopBudget;
+  }
+
+  int getLoopBudgetMultiplier() const {
+    return loopBudgetMultiplier;
+  }
+
+  /// Do not compile nor run mutants that are equivalent to the original
+  /// code or to another mutant, see EquivalentMutantFilter.
+  bool isEquivalentMutantPruningEnabled() const {
+    return equivalentMutantPruning;
+  }
+
+  /// Compare the machine code of each mutated function with the original
+  /// one and with the other mutants, see hashFunctionCode. Identical code
+  /// is not run again.
+  bool isTrivialCompilerEquivalenceEnabled() const {
+    return trivialCompilerEquivalence;
+  }
+
+  /// Unique identifiers of the operators to use, all of them when empty.
+  /// See MutationOperatorRegistry.
+  const std::vector<std::string> &getMutationOperators() const {
+    return mutationOperators;
+  }
+
+  /// Globs restricting the functions to mutate by source path and by
+  /// (mangled or demangled) name, see FunctionFilter
+  const std::vector<std::string> &getIncludeLocations() const {
+    return includeLocations;
+  }
+
+  const std::vector<std::string> &getExcludeLocations() const {
+    return excludeLocations;
+  }
+
+  const std::vector<std::string> &getIncludeFunctions() const {
+    return includeFunctions;
+  }
+
+  const std::vector<std::string> &getExcludeFunctions() const {
+    return excludeFunctions;
+  }
+
+  /// Results database of a previous run. Mutants whose function and tests
+  /// did not change since then are not run again, see Baseline.
+  ///
+  /// A test counts as unchanged when the functions it reaches are. Only
+  /// direct calls up to max_distance are followed, so a change in a
+  /// function called through a pointer or a virtual call, or further away
+  /// than max_distance, does not make the test run again.
+  const std::string &getBaselineDatabase() const {
+    return baselineDatabase;
+  }
+
+  /// Run only the share of the mutants assigned to this shard,
+  /// see ShardPlanner. Shards are numbered from zero.
+  int getShardIndex() const {
+    return shardIndex;
+  }
+
+  int getShardCount() const {
+    return shardCount;
+  }
+
+  /// Number of worker processes running the mutants, zero runs them in
+  /// the driver itself, see WorkerProtocol
+  int getWorkers() const {
+    return workers;
+  }
+
+  /// Unix domain socket the workers connect to, a path in /tmp unique to
+  /// the driver process is used when empty
+  const std::string &getWorkerSocket() const {
+    return workerSocket;
+  }
+
+  /// Shell command starting one worker, with every '{socket}' replaced by
+  /// the socket path, e.g. 'ssh -R /tmp/w.sock:{socket} host mutang-driver
+  /// -worker=/tmp/w.sock config.yml'. When empty the driver forks local workers
+  const std::string &getWorkerCommand() const {
+    return workerCommand;
+  }
+
+  /// Chrome trace of the phases of the run, see Trace. No tracing when empty
+  const std::string &getTraceFile() const {
+    return traceFile;
+  }
+
+  /// Megabytes a forked test may allocate, zero for no limit,
+  /// see ForkProcessSandbox
+  int getMemoryLimit() const {
+    return memoryLimit;
+  }
+
+  /// Seconds of CPU time a forked test may use, zero for no limit
+  int getCPULimit() const {
+    return cpuLimit;
+  }
+
 };
 }
 
@@ -2,6 +2,8 @@
 
 #include "Config.h"
 
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/YAMLTraits.h"
 
 #ifndef YAML_STRING_SEQUENCE
@@ -24,6 +26,32 @@ struct MappingTraits<Mutang::Config>
     io.mapOptional("timeout", config.timeout);
     io.mapOptional("max_distance", config.maxDistance);
     io.mapOptional("cache_directory", config.cacheDirectory);
+    io.mapOptional("emit_debug_info", config.emitDebugInfo);
+    io.mapOptional("zygote", config.zygote);
+    io.mapOptional("mutant_centric", config.mutantCentric);
+    io.mapOptional("coverage_pruning", config.coveragePruning);
+    io.mapOptional("timeout_multiplier", config.timeoutMultiplier);
+    io.mapOptional("min_timeout", config.minimumTimeout);
+    io.mapOptional("max_timeout", config.maximumTimeout);
+    io.mapOptional("timing_samples", config.timingSamples);
+    io.mapOptional("loop_budget", config.loopBudget);
+    io.mapOptional("loop_budget_multiplier", config.loopBudgetMultiplier);
+    io.mapOptional("equivalent_mutant_pruning", config.equivalentMutantPruning);
+    io.mapOptional("trivial_compiler_equivalence", config.trivialCompilerEquivalence);
+    io.mapOptional("mutation_operators", config.mutationOperators);
+    io.mapOptional("include_locations", config.includeLocations);
+    io.mapOptional("exclude_locations", config.excludeLocations);
+    io.mapOptional("include_functions", config.includeFunctions);
+    io.mapOptional("exclude_functions", config.excludeFunctions);
+    io.mapOptional("baseline", config.baselineDatabase);
+    io.mapOptional("shard_index", config.shardIndex);
+    io.mapOptional("shard_count", config.shardCount);
+    io.mapOptional("workers", config.workers);
+    io.mapOptional("worker_socket", config.workerSocket);
+    io.mapOptional("worker_command", config.workerCommand);
+    io.mapOptional("trace_file", config.traceFile);
+    io.mapOptional("memory_limit", config.memoryLimit);
+    io.mapOptional("cpu_limit", config.cpuLimit);
   }
 };
 }
@@ -31,6 +59,13 @@ struct MappingTraits<Mutang::Config>
 
 namespace Mutang {
 
+/// Exit code of a run refused because of its config
+static const int ConfigurationErrorExitCode = 2;
+
+/// Reports a config value Mutang cannot run with and exits. Guessing a
+/// usable value instead would silently produce different results.
+LLVM_ATTRIBUTE_NORETURN void configurationError(const llvm::Twine &message);
+
 class ConfigParser {
 public:
   Config loadConfig(llvm::yaml::Input &input);
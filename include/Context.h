@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ModuleLoader.h"
+#include "Testee.h"
 
 #include "llvm/IR/Module.h"
 
@@ -26,6 +27,10 @@ private:
   std::map<std::string, llvm::Function *> FunctionsRegistry;
   std::map<std::string, MutangModule *> moduleRegistry;
 
+  /// Testees refer to functions of the modules above, hence they live
+  /// exactly as long as the modules do.
+  TesteeArena testees;
+
 public:
   void addModule(std::unique_ptr<MutangModule> module);
 
@@ -36,6 +41,7 @@ public:
 
   ModuleArrayType &getModules() { return Modules; }
   llvm::Function *lookupDefinedFunction(llvm::StringRef FunctionName);
+  TesteeArena &getTesteeArena() { return testees; }
   iterator begin()  { return Modules.begin(); }
   iterator end()    { return Modules.end();   }
 };
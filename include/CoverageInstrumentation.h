@@ -0,0 +1,58 @@
+#pragma once
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Module.h"
+
+#include <vector>
+
+namespace llvm {
+
+class BasicBlock;
+
+}
+
+namespace Mutang {
+
+class MutationPoint;
+
+/// Finds out which basic blocks are executed by a test.
+///
+/// Each module gets a clone in which every basic block starts with a store
+/// marking the block as executed. The marks live in memory shared with the
+/// forked sandboxes, so they can be collected by the parent once the
+/// instrumented program has run.
+class CoverageInstrumentation {
+  /// Blocks of the original (not instrumented) modules, indexed by
+  /// the position of their mark
+  std::vector<llvm::BasicBlock *> blocks;
+  llvm::DenseMap<llvm::BasicBlock *, unsigned> blockIndices;
+
+  uint8_t *marks;
+  size_t marksSize;
+
+public:
+  CoverageInstrumentation();
+  ~CoverageInstrumentation();
+
+  CoverageInstrumentation(const CoverageInstrumentation &) = delete;
+  CoverageInstrumentation &operator=(const CoverageInstrumentation &) = delete;
+
+  /// Instruments the clone of the original module, the original module
+  /// itself stays intact
+  void instrument(llvm::Module &original, llvm::Module &clone);
+
+  /// Allocates the marks for all the blocks instrumented so far,
+  /// must be called before the instrumented code runs
+  void allocateMarks();
+
+  void resetMarks();
+  llvm::BitVector collectCoverage() const;
+
+  /// Mutation points that are not instructions of an instrumented
+  /// module are considered covered
+  bool isCovered(const llvm::BitVector &coverage,
+                 MutationPoint *mutationPoint) const;
+};
+
+}
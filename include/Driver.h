@@ -1,15 +1,29 @@
 #pragma once
 
+#include "Baseline.h"
 #include "Config.h"
 #include "TestResult.h"
 #include "ForkProcessSandbox.h"
+#include "FunctionFilter.h"
+#include "FunctionHasher.h"
 #include "Context.h"
+#include "CoverageInstrumentation.h"
+#include "EquivalentMutantFilter.h"
+#include "LoopBudget.h"
+#include "ShardPlanner.h"
+#include "TimeoutPolicy.h"
+#include "WorkerProtocol.h"
 
 #include "Toolchain/Toolchain.h"
 
 #include "llvm/Object/ObjectFile.h"
 
 #include <map>
+#include <set>
+#include <string>
+#include <sys/types.h>
+#include <tuple>
+#include <vector>
 
 namespace llvm {
 
@@ -34,13 +48,65 @@ class Driver {
   Toolchain &toolchain;
   Context Ctx;
   ProcessSandbox *Sandbox;
+  TimeoutPolicy timeoutPolicy;
+  EquivalentMutantFilter equivalentMutantFilter;
+  FunctionFilter functionFilter;
+  FunctionHasher functionHasher;
+  Baseline baseline;
+  ShardPlanner shardPlanner;
+  int carriedResults;
 
   std::map<llvm::Module *, llvm::object::ObjectFile *> InnerCache;
+
+  /// Only present when the corresponding instrumentation is enabled
+  std::unique_ptr<CoverageInstrumentation> coverage;
+  std::unique_ptr<LoopBudget> loopBudget;
+  std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> InstrumentedObjects;
+
+  /// A test that reaches a mutation point and may kill the mutant,
+  /// used in mutant-centric mode
+  struct KillerCandidate {
+    TestResult *testResult;
+    Test *test;
+    Testee *testee;
+    long long timeout;
+    uint64_t iterationBudget;
+  };
+
+  /// Mutation points in the order of discovery along with their candidates
+  std::vector<std::pair<MutationPoint *, std::vector<KillerCandidate>>> killerCandidates;
+  std::map<std::string, size_t> killerCandidateIndices;
+
+  /// Trivial compiler equivalence: hashes of the machine code of mutated
+  /// functions, keyed by the object and the name of the function, and the
+  /// results of mutants run so far. Mutants of different functions run in
+  /// different programs, so a result is only shared by mutants of the same
+  /// test, module and function compiling to the same code.
+  std::map<std::pair<llvm::object::ObjectFile *, std::string>, std::string> functionCodeHashes;
+  std::map<std::tuple<Test *, std::string, std::string, std::string>, ExecutionResult> resultsByFunctionCode;
+  int equivalentCodeMutants;
+  int duplicateCodeMutants;
+
+  /// Mutants left to the workers, see runJobsOnWorkers
+  struct RemoteJob {
+    MutationPoint *mutationPoint;
+    KillerCandidate candidate;
+  };
+  std::vector<RemoteJob> remoteJobs;
+
+  /// Worker side: the tests by name and the mutation points by unique
+  /// identifier along with the module they mutate
+  std::vector<std::unique_ptr<Test>> workerTests;
+  std::map<std::string, Test *> testsByName;
+  std::set<Test *> resolvedTests;
+  std::map<std::string, std::pair<MutationPoint *, llvm::Module *>> workerMutationPoints;
 public:
   Driver(Config &C, ModuleLoader &ML, TestFinder &TF, TestRunner &TR, Toolchain &t)
-    : Cfg(C), Loader(ML), Finder(TF), Runner(TR), toolchain(t) {
+    : Cfg(C), Loader(ML), Finder(TF), Runner(TR), toolchain(t),
+      timeoutPolicy(C), functionFilter(C), shardPlanner(C), carriedResults(0),
+      equivalentCodeMutants(0), duplicateCodeMutants(0) {
       if (C.getFork()) {
-        this->Sandbox = new ForkProcessSandbox();
+        this->Sandbox = new ForkProcessSandbox(C.getMemoryLimit(), C.getCPULimit());
       } else {
         this->Sandbox = new NullProcessSandbox();
       }
@@ -52,11 +118,63 @@ public:
 
   std::unique_ptr<Result> Run();
 
+  /// Loads the program and runs the jobs of the coordinator listening
+  /// on the socket until it has no more of them
+  void RunWorker(const std::string &socketPath);
+
   void debug_PrintTestNames();
   void debug_PrintTesteeNames();
   void debug_PrintMutationPoints();
 
 private:
+  /// Runs the test against the mutant, object files must contain all
+  /// the modules except the mutated one
+  ExecutionResult runMutant(MutationPoint *mutationPoint,
+                            Test *test,
+                            std::vector<llvm::object::ObjectFile *> &objectFiles,
+                            long long timeout,
+                            uint64_t iterationBudget);
+
+  std::vector<MutationPoint *> OwnMutationPoints(const std::vector<MutationPoint *> &mutationPoints,
+                                                Test *test,
+                                                uint64_t cost);
+
+  /// Result of the same mutant and test in the baseline run, if neither
+  /// of them changed since
+  const ExecutionResult *baselineResult(Test *test,
+                                        const std::string &testeesHash,
+                                        MutationPoint *mutationPoint);
+
+  llvm::object::ObjectFile *compileMutant(MutationPoint *mutationPoint);
+  llvm::object::ObjectFile *compileMutantWithLoopBudget(MutationPoint *mutationPoint);
+  const std::string &functionCodeHash(llvm::object::ObjectFile *object,
+                                      MutationPoint *mutationPoint);
+
+  void addKillerCandidate(MutationPoint *mutationPoint,
+                          TestResult *testResult,
+                          Test *test,
+                          Testee *testee,
+                          long long timeout,
+                          uint64_t iterationBudget);
+  void runMutantsByKillLikelihood();
+
+  void runJobsOnWorkers();
+  std::vector<pid_t> startWorkers(const std::string &socketPath, int listener);
+  void serveJobs(const std::string &socketPath);
+  void indexWorkerTests();
+  ExecutionResult runWorkerJob(const WorkerJob &job);
+
+  /// Loads and compiles all modules and links them into the runner,
+  /// returns their object files
+  std::vector<llvm::object::ObjectFile *> LoadProgram();
+
+  /// Compiles instrumented copies of all modules,
+  /// see CoverageInstrumentation and LoopBudget
+  std::vector<llvm::object::ObjectFile *> InstrumentProgram(bool withCoverage,
+                                                            bool withLoopBudget);
+
+  static ExecutionResult NotCoveredResult();
+
   /// Returns cached object files for all modules excerpt one provided
   std::vector<llvm::object::ObjectFile *> AllButOne(llvm::Module *One);
 
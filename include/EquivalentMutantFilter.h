@@ -0,0 +1,51 @@
+#pragma once
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+
+#include <string>
+#include <vector>
+
+namespace Mutang {
+
+class MutationPoint;
+
+/// Drops mutants that cannot be killed before they are compiled and run.
+///
+/// The mutated function and the original one are both cleaned up by
+/// instruction simplification and dead code elimination and then compared
+/// structurally. A mutant is equivalent when its function is identical to
+/// the original one (e.g. `x + 0` turned into `x - 0`, or a negated
+/// comparison that is never used), and redundant when it is identical to
+/// a mutant of the same function seen before.
+class EquivalentMutantFilter {
+  /// Simplified original functions keyed by module and function index
+  llvm::StringMap<std::string> originalFunctions;
+  llvm::StringSet<> mutatedFunctions;
+
+  /// Verdicts keyed by the unique identifier of a mutation point, the same
+  /// point is found for every test that reaches it
+  llvm::StringMap<bool> verdicts;
+
+  int equivalentCount;
+  int redundantCount;
+
+  const std::string &simplifiedOriginal(MutationPoint *mutationPoint);
+
+public:
+  EquivalentMutantFilter() : equivalentCount(0), redundantCount(0) {}
+
+  bool shouldSkip(MutationPoint *mutationPoint);
+
+  std::vector<MutationPoint *> filter(const std::vector<MutationPoint *> &mutationPoints);
+
+  int getEquivalentCount() const {
+    return equivalentCount;
+  }
+
+  int getRedundantCount() const {
+    return redundantCount;
+  }
+};
+
+}
@@ -12,8 +12,27 @@ public:
                               long long timeoutMilliseconds) = 0;
 };
 
+/// Exit code of a sandboxed process that failed to allocate memory
+/// within its memory limit
+static const int ResourceLimitExceededExitCode = 118;
+
+/// Runs each test in a process of its own.
+///
+/// The process may be given a memory limit, in megabytes it may allocate on
+/// top of what it inherits, and a limit of CPU time in seconds. Reaching
+/// either of them ends the process with the ResourceLimitExceeded status
+/// instead of taking the whole machine down. Zero means no limit.
+///
+/// A failed allocation is told apart from a crash by errno being ENOMEM
+/// when the process faults, so a test that handles a failed malloc and
+/// crashes later for another reason is reported as a crash.
 class ForkProcessSandbox : public ProcessSandbox {
+  long long memoryLimit;
+  long long cpuLimit;
 public:
+  explicit ForkProcessSandbox(long long memoryLimit = 0, long long cpuLimit = 0)
+    : memoryLimit(memoryLimit), cpuLimit(cpuLimit) {}
+
   ExecutionResult run(std::function<void (ExecutionResult *)> function,
                       long long timeoutMilliseconds);
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/GlobPattern.h"
+
+#include <string>
+#include <vector>
+
+namespace llvm {
+
+class Function;
+
+}
+
+namespace Mutang {
+
+class Config;
+
+/// Decides which functions may be mutated at all.
+///
+/// Source paths are matched against the location of the function in debug
+/// info, names are matched both mangled and demangled. A function is
+/// mutated when it matches the include patterns (if there are any) and
+/// none of the exclude patterns. Patterns are globs, e.g. "*/third_party/*"
+/// or "llvm::APInt::*". An invalid pattern is a configuration error.
+///
+/// The verdict is computed once per function, before any of its mutation
+/// points are created.
+class FunctionFilter {
+  std::vector<llvm::GlobPattern> includedLocations;
+  std::vector<llvm::GlobPattern> excludedLocations;
+  std::vector<llvm::GlobPattern> includedNames;
+  std::vector<llvm::GlobPattern> excludedNames;
+
+  llvm::DenseMap<llvm::Function *, bool> verdicts;
+
+  bool computeShouldSkip(llvm::Function &function) const;
+
+public:
+  FunctionFilter(const std::vector<std::string> &includeLocations,
+                 const std::vector<std::string> &excludeLocations,
+                 const std::vector<std::string> &includeFunctions,
+                 const std::vector<std::string> &excludeFunctions);
+  explicit FunctionFilter(const Config &config);
+
+  bool shouldSkipFunction(llvm::Function &function);
+};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <string>
+
+namespace llvm {
+
+class Function;
+class Module;
+
+}
+
+namespace Mutang {
+
+class Context;
+class MutationPoint;
+
+/// Hashes functions so that they can be recognized across runs.
+///
+/// The hash covers the printed IR of the function and of the globals it
+/// refers to, their initializers included, without metadata. Moving a
+/// function within its file or changing another function in the same
+/// module (which renumbers the metadata) keeps its hash, changing a
+/// constant table it reads does not.
+class FunctionHasher {
+  llvm::DenseMap<llvm::Function *, std::string> hashes;
+  llvm::DenseMap<llvm::Module *, std::string> reachableCodeHashes;
+
+public:
+  const std::string &hashFunction(llvm::Function &function);
+
+  /// Identifies a mutation point by the hash of its function rather than
+  /// by the hash of its module, see MutationPoint::getUniqueIdentifier
+  std::string stableIdentifier(MutationPoint *mutationPoint);
+
+  /// Hash of all the functions a test may run: its own module, the static
+  /// constructors and whatever those refer to, at any distance and through
+  /// function pointers too. Unlike the testees of a test it does not depend
+  /// on max_distance nor misses indirect calls.
+  const std::string &hashReachableCode(llvm::Function &testFunction,
+                                       Context &context);
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "MutationPoint.h"
 #include "MutationOperators/MutationOperator.h"
+#include "MutationOperators/MutationPointScanner.h"
 #include "TestFinder.h"
 
 #include "llvm/ADT/StringMap.h"
@@ -27,17 +28,14 @@ class GoogleTestFinder : public TestFinder {
   std::map<llvm::Function *, std::vector<MutationPoint *>> MutationPointsRegistry;
 
   std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  MutationPointScanner scanner;
 public:
-  explicit GoogleTestFinder();
+  explicit GoogleTestFinder(std::vector<std::unique_ptr<MutationOperator>> mutationOperators);
 
   std::vector<std::unique_ptr<Test>> findTests(Context &Ctx) override;
-  std::vector<std::unique_ptr<Testee>> findTestees(Test *Test,
-                                                   Context &Ctx,
-                                                   int maxDistance) override;
-
-  std::vector<std::unique_ptr<MutationPoint>> findMutationPoints(
-                          std::vector<MutationOperator *> &MutationOperators,
-                          llvm::Function &F) override;
+  std::vector<Testee *> findTestees(Test *Test,
+                                    Context &Ctx,
+                                    int maxDistance) override;
 
   std::vector<MutationPoint *> findMutationPoints(const Context &context,
                                                   llvm::Function &F) override;
@@ -2,12 +2,13 @@
 
 #include "TestRunner.h"
 
-#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Target/TargetMachine.h"
 
+#include <map>
+
 namespace llvm {
 
 class Function;
@@ -15,16 +16,32 @@ class Module;
 
 }
 
+/// Destructors the JIT-ed code registers through __cxa_atexit. Each pair of
+/// dso handle and argument is registered once, destructors run in reverse
+/// order of registration.
+extern "C" int mutang__cxa_atexit(void (*destructor)(void *), void *arg, void *dsoHandle);
+void runDestructors();
+
 namespace Mutang {
 
   class GoogleTestRunner : public TestRunner {
-  llvm::orc::ObjectLinkingLayer<> ObjectLayer;
   llvm::Mangler Mangler;
+  bool ProgramInitialized;
+
+  /// Each object set gets its own __dso_handle, so the destructors it
+  /// registers can be told apart from the ones of other sets
+  std::map<llvm::object::ObjectFile *, void *> DSOHandles;
 public:
 
   GoogleTestRunner(llvm::TargetMachine &machine);
+  void initializeProgram(Test *Test) override;
   ExecutionResult runTest(Test *Test, ObjectFiles &ObjectFiles) override;
 
+protected:
+  std::unique_ptr<llvm::JITSymbolResolver>
+  createResolver(llvm::object::ObjectFile *objectFile) override;
+  void willUnloadObjectFiles(const std::vector<llvm::object::ObjectFile *> &objectFiles) override;
+
 private:
   std::string MangleName(const llvm::StringRef &Name);
   void *GetCtorPointer(const llvm::Function &Function);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mutang {
+
+/// Exit code of a sandboxed process that ran out of its loop budget
+static const int LoopBudgetExceededExitCode = 117;
+
+/// Ends mutants stuck in infinite loops without waiting for the timeout.
+///
+/// The original program counts how many times the back-edges of each
+/// function are taken during a test. The mutated function of a mutant gets
+/// a guard on each of its back-edges: once they are taken more times than
+/// the budget derived from the original count allows, the process exits
+/// with LoopBudgetExceededExitCode.
+///
+/// Exiting only makes sense in a forked sandbox.
+class LoopBudget {
+  /// Functions of the original (not instrumented) modules, indexed by
+  /// the position of their counter
+  std::vector<llvm::Function *> functions;
+  llvm::DenseMap<llvm::Function *, unsigned> functionIndices;
+
+  uint64_t *counters;
+  size_t countersSize;
+
+  uint64_t multiplier;
+
+public:
+  /// Budget given to functions whose loops the original test never ran
+  static const uint64_t MinimumBudget = 1000000;
+
+  explicit LoopBudget(uint64_t multiplier);
+  ~LoopBudget();
+
+  LoopBudget(const LoopBudget &) = delete;
+  LoopBudget &operator=(const LoopBudget &) = delete;
+
+  /// Adds back-edge counters to the clone of the original module
+  void instrumentCounters(llvm::Module &original, llvm::Module &clone);
+
+  /// Allocates the counters for all the functions instrumented so far,
+  /// must be called before the instrumented code runs
+  void allocateCounters();
+
+  void resetCounters();
+  std::vector<uint64_t> collectCounts() const;
+
+  uint64_t budgetFor(const std::vector<uint64_t> &counts,
+                     llvm::Function *function) const;
+
+  /// Guards the back-edges of the (mutated) function with the budget
+  static void instrumentBudget(llvm::Function &function);
+
+  /// Sets the budget for the next run of the guarded code
+  static void setBudget(uint64_t budget);
+};
+
+}
@@ -2,20 +2,16 @@
 
 #include "MutationOperators/MutationOperator.h"
 
+#include "llvm/IR/Instruction.h"
+
 #include <vector>
 
 namespace Mutang {
 
-class MutationPoint;
 class MutationPointAddress;
-class MutationOperatorFilter;
 
 class AddMutationOperator : public MutationOperator {
 public:
-  std::vector<MutationPoint *> getMutationPoints(const Context &context,
-                                                 llvm::Function *function,
-                                                 MutationOperatorFilter &filter) override;
-
   std::string uniqueID() override {
     return "add_mutation_operator";
   }
@@ -23,6 +19,10 @@ public:
     return "add_mutation_operator";
   }
 
+  std::vector<unsigned> getOpcodes() const override {
+    return { llvm::Instruction::Add, llvm::Instruction::FAdd };
+  }
+
   bool canBeApplied(llvm::Value &V) override;
   llvm::Value *applyMutation(llvm::Module *M, MutationPointAddress address, llvm::Value &OriginalValue) override;
   llvm::Value *revertMutation(llvm::Value &Value) override __attribute__((unavailable));
@@ -13,21 +13,19 @@ namespace llvm {
 
 namespace Mutang {
 
-class Context;
-class MutationPoint;
 class MutationPointAddress;
 class MutationOperatorFilter;
 
 class MutationOperator {
 public:
-  virtual std::vector<MutationPoint *> getMutationPoints(const Context &context,
-                                                         llvm::Function *function,
-                                                         MutationOperatorFilter &filter) = 0;
-
   /// FIXME: Renmae to 'getUniqueIdentifier'
   virtual std::string uniqueID() = 0;
   virtual std::string uniqueID() const = 0;
 
+  /// Opcodes of the instructions the operator may mutate,
+  /// see MutationPointScanner
+  virtual std::vector<unsigned> getOpcodes() const = 0;
+
   virtual bool canBeApplied(llvm::Value &V) = 0;
   virtual llvm::Value *applyMutation(llvm::Module *M, MutationPointAddress address, llvm::Value &OriginalValue) = 0;
   virtual llvm::Value *revertMutation(llvm::Value &Value) = 0;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "MutationOperators/MutationOperator.h"
+
+#include "llvm/ADT/STLExtras.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mutang {
+
+/// Maps the unique identifier of each mutation operator to a factory,
+/// so that the set of operators can be picked by configuration.
+class MutationOperatorRegistry {
+  typedef std::function<std::unique_ptr<MutationOperator>()> Factory;
+  std::map<std::string, Factory> factories;
+
+public:
+  /// Registers all the operators shipped with Mutang
+  MutationOperatorRegistry();
+
+  template <class Operator>
+  void registerOperator() {
+    factories[Operator().uniqueID()] = [] {
+      return llvm::make_unique<Operator>();
+    };
+  }
+
+  std::vector<std::string> getIdentifiers() const;
+
+  /// Creates the operators in the given order. An empty list stands for
+  /// all the registered operators, an unknown identifier is a
+  /// configuration error.
+  std::vector<std::unique_ptr<MutationOperator>>
+  createOperators(const std::vector<std::string> &identifiers) const;
+};
+
+}
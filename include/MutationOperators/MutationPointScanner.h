@@ -0,0 +1,35 @@
+#pragma once
+
+#include "MutationOperators/MutationOperator.h"
+#include "MutationPoint.h"
+
+#include <memory>
+#include <vector>
+
+namespace llvm {
+  class Function;
+}
+
+namespace Mutang {
+
+class Context;
+class MutationOperatorFilter;
+
+/// Finds the mutation points of all the operators in a single walk over
+/// a function.
+///
+/// Operators are looked up by the opcode of each instruction, see
+/// MutationOperator::getOpcodes, so an instruction is only offered to the
+/// operators that may mutate it.
+class MutationPointScanner {
+  std::vector<std::vector<MutationOperator *>> operatorsByOpcode;
+
+public:
+  explicit MutationPointScanner(const std::vector<std::unique_ptr<MutationOperator>> &mutationOperators);
+
+  std::vector<std::unique_ptr<MutationPoint>> scan(const Context &context,
+                                                   llvm::Function &function,
+                                                   MutationOperatorFilter &filter) const;
+};
+
+}
@@ -8,17 +8,12 @@
 
 namespace Mutang {
 
-  class MutationPoint;
   class MutationPointAddress;
-  class MutationOperatorFilter;
 
   class NegateConditionMutationOperator : public MutationOperator {
 
   public:
     static llvm::CmpInst::Predicate negatedCmpInstPredicate(llvm::CmpInst::Predicate predicate);
-    std::vector<MutationPoint *> getMutationPoints(const Context &context,
-                                                   llvm::Function *function,
-                                                   MutationOperatorFilter &filter) override;
 
     std::string uniqueID() override {
       return "negate_mutation_operator";
@@ -27,6 +22,10 @@ namespace Mutang {
       return "negate_mutation_operator";
     }
 
+    std::vector<unsigned> getOpcodes() const override {
+      return { llvm::Instruction::ICmp, llvm::Instruction::FCmp };
+    }
+
     bool canBeApplied(llvm::Value &V) override;
     llvm::Value *applyMutation(llvm::Module *M, MutationPointAddress address, llvm::Value &OriginalValue) override;
     llvm::Value *revertMutation(llvm::Value &Value) override __unavailable;
@@ -8,17 +8,11 @@
 
 namespace Mutang {
 
-  class MutationPoint;
   class MutationPointAddress;
-  class MutationOperatorFilter;
 
   class RemoveVoidFunctionMutationOperator : public MutationOperator {
 
   public:
-    std::vector<MutationPoint *> getMutationPoints(const Context &context,
-                                                   llvm::Function *function,
-                                                   MutationOperatorFilter &filter) override;
-
     std::string uniqueID() override {
       return "remove_void_function_mutation_operator";
     }
@@ -26,6 +20,10 @@ namespace Mutang {
       return "remove_void_function_mutation_operator";
     }
 
+    std::vector<unsigned> getOpcodes() const override {
+      return { llvm::Instruction::Call };
+    }
+
     bool canBeApplied(llvm::Value &V) override;
     llvm::Value *applyMutation(llvm::Module *M, MutationPointAddress address, llvm::Value &OriginalValue) override;
     llvm::Value *revertMutation(llvm::Value &Value) override __unavailable;
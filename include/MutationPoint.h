@@ -68,10 +68,14 @@ public:
   MutationOperator *getOperator() const;
   MutationPointAddress getAddress() const;
   llvm::Value *getOriginalValue() const;
+  MutangModule *getOriginalModule() const;
 
   void applyMutation(llvm::Module *M) __attribute__((deprecated));
   llvm::object::OwningBinary<llvm::object::ObjectFile> applyMutation(Compiler &compiler);
 
+  /// Returns a copy of the original module with the mutation applied
+  std::unique_ptr<llvm::Module> cloneModuleAndApplyMutation();
+
   std::string getUniqueIdentifier();
   std::string getUniqueIdentifier() const;
 };
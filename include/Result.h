@@ -2,16 +2,39 @@
 
 #include "Testee.h"
 #include "TestResult.h"
+
+#include "llvm/ADT/StringMap.h"
+
+#include <map>
 #include <vector>
 
+namespace llvm {
+  class Instruction;
+}
+
 namespace Mutang {
+  /// Tests are owned by their TestResults, inside the Result. Testees are
+  /// owned by the Context of the Driver that produced the Result and
+  /// mutation points by its TestFinder, the Result only refers to them.
+  /// The Driver, its Context and the TestFinder must outlive the Result.
   class Result {
     std::vector<std::unique_ptr<TestResult>> testResults;
-    std::vector<std::unique_ptr<Testee>> allTestees;
+    std::vector<Testee *> allTestees;
+
+    /// Caller paths are calculated once per Testee and shared by all the
+    /// mutation results reached through it. Path components are indices
+    /// into the 'locations' table, each "file:line" is interned only once.
+    std::map<Testee *, std::vector<int>> testeeCallerPaths;
+    std::map<llvm::Instruction *, int> instructionLocations;
+    llvm::StringMap<int> locationIndices;
+    std::vector<std::string> locations;
+
+    const std::vector<int> &calculateTesteeCallerPath(Testee *testee);
+    int locationOfInstruction(llvm::Instruction *instruction);
 
   public:
     Result(std::vector<std::unique_ptr<TestResult>> testResults,
-           std::vector<std::unique_ptr<Testee>> allTestees) :
+           std::vector<Testee *> allTestees) :
       testResults(std::move(testResults)),
       allTestees(std::move(allTestees)) {}
 
@@ -19,7 +42,7 @@ namespace Mutang {
       return testResults;
     }
 
-    std::vector<std::unique_ptr<Testee>> const& getAllTestees() {
+    std::vector<Testee *> const& getAllTestees() {
       return allTestees;
     }
 
@@ -4,18 +4,29 @@
 
 namespace Mutang {
 
+class Config;
 class Result;
 
 class SQLiteReporter {
 
 private:
   std::string databasePath;
+  bool emitDebugInfo;
 
 public:
   SQLiteReporter();
-  
+  SQLiteReporter(const Config &config);
+
+
   void reportResults(const std::unique_ptr<Result> &result);
+
+  /// Writes the results of all the shards of a run into a single database,
+  /// see ShardPlanner. Every shard runs all the tests, the original results
+  /// are taken from the first shard that has the test, the same goes for
+  /// a mutant that several shards ran.
+  void mergeDatabases(const std::vector<std::string> &shardDatabasePaths);
   std::string getDatabasePath();
+  void setDatabasePath(const std::string &path);
 
   // Exposed for testing.
   std::string getCallerPathAsString(const std::vector<std::string> &callerPath);
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "llvm/ADT/StringMap.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mutang {
+
+class Config;
+
+/// Splits the jobs of a run between several independent processes.
+///
+/// Every shard goes through the same jobs in the same order and makes the
+/// same decisions, so no coordination is needed: a job is given to the
+/// least loaded shard so far, ties are broken by the MD5 hash of the job.
+/// The estimated cost of a job must therefore be deterministic as well,
+/// measured running times would differ from shard to shard.
+class ShardPlanner {
+  int shardIndex;
+  int shardCount;
+
+  std::vector<uint64_t> loads;
+  llvm::StringMap<int> assignments;
+
+public:
+  ShardPlanner(int shardIndex, int shardCount);
+  explicit ShardPlanner(const Config &config);
+
+  bool isSharded() const {
+    return shardCount > 1;
+  }
+
+  /// Returns the shard of the job, the same job always goes to the same shard
+  int assign(const std::string &job, uint64_t cost);
+
+  bool isOwnJob(const std::string &job, uint64_t cost) {
+    return assign(job, cost) == shardIndex;
+  }
+};
+
+}
@@ -4,6 +4,7 @@
 #include "Test.h"
 
 #include "MutationOperators/MutationOperator.h"
+#include "MutationOperators/MutationPointScanner.h"
 
 #include <map>
 #include <vector>
@@ -24,6 +25,7 @@ class SimpleTestFinder : public TestFinder {
 
   std::vector<std::unique_ptr<MutationPoint>> MutationPoints;
   std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  MutationPointScanner scanner;
   std::map<llvm::Function *, std::vector<MutationPoint *>> MutationPointsRegistry;
 
 public:
@@ -31,15 +33,12 @@ public:
 
   // Finds all methods that start with "test_"
   std::vector<std::unique_ptr<Test>> findTests(Context &Ctx) override;
-  std::vector<std::unique_ptr<Testee>> findTestees(Test *Test,
-                                                   Context &Ctx,
-                                                   int distance) override;
+  std::vector<Testee *> findTestees(Test *Test,
+                                    Context &Ctx,
+                                    int distance) override;
 
   std::vector<MutationPoint *> findMutationPoints(const Context &context,
                                                   llvm::Function &F) override;
-  std::vector<std::unique_ptr<MutationPoint>> findMutationPoints(
-                          std::vector<MutationOperator *> &MutationOperators,
-                          llvm::Function &F) override;
 };
 
 }
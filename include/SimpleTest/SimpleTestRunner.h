@@ -2,7 +2,6 @@
 
 #include "TestRunner.h"
 
-#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
 #include "llvm/IR/Mangler.h"
 
 namespace llvm {
@@ -17,12 +16,15 @@ namespace Mutang {
 class Test;
 
 class SimpleTestRunner : public TestRunner {
-  llvm::orc::ObjectLinkingLayer<> ObjectLayer;
   llvm::Mangler Mangler;
 public:
   SimpleTestRunner(llvm::TargetMachine &targetMachine);
   ExecutionResult runTest(Test *Test, TestRunner::ObjectFiles &ObjectFiles) override;
 
+protected:
+  std::unique_ptr<llvm::JITSymbolResolver>
+  createResolver(llvm::object::ObjectFile *objectFile) override;
+
 private:
   std::string MangleName(const llvm::StringRef &Name);
   void *TestFunctionPointer(const llvm::Function &Function);
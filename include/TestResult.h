@@ -22,14 +22,33 @@ enum ExecutionStatus {
   Passed,
   Timedout,
   Crashed,
-  DryRun
+  DryRun,
+  NotCovered,
+  LoopBudgetExceeded,
+  Equivalent,
+  ResourceLimitExceeded
+};
+
+/// Resources used by the process that ran a test, as reported by wait4
+struct ResourceUsage {
+  /// Microseconds
+  long long UserTime = 0;
+  long long SystemTime = 0;
+  /// Kilobytes
+  long MaxRSS = 0;
+  long MajorFaults = 0;
+  long MinorFaults = 0;
+  /// Voluntary and involuntary
+  long ContextSwitches = 0;
 };
 
 struct ExecutionResult {
   ExecutionStatus Status;
+  /// Microseconds
   long long RunningTime;
   std::string stdoutOutput;
   std::string stderrOutput;
+  ResourceUsage Usage;
 };
 
 class MutationResult {
@@ -51,9 +70,14 @@ class TestResult {
   ExecutionResult OriginalTestResult;
   std::unique_ptr<Test> TestPtr;
   std::vector<std::unique_ptr<MutationResult>> MutationResults;
+  /// See FunctionHasher::hashReachableCode
+  std::string TesteesHash;
 public:
   TestResult(ExecutionResult OriginalResult, std::unique_ptr<Test> T);
 
+  void setTesteesHash(const std::string &hash) { TesteesHash = hash; }
+  const std::string &getTesteesHash() const { return TesteesHash; }
+
   void addMutantResult(std::unique_ptr<MutationResult> Res);
 
   std::string getTestName();
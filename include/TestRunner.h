@@ -2,25 +2,96 @@
 
 #include "TestResult.h"
 
+#include "llvm/ExecutionEngine/JITSymbol.h"
+#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Target/TargetMachine.h"
 
+#include <map>
+#include <set>
+#include <vector>
+
 namespace Mutang {
 
 class Test;
 
 class TestRunner {
-protected:
-  llvm::TargetMachine &machine;
 public:
   typedef std::vector<llvm::object::ObjectFile *> ObjectFiles;
   typedef std::vector<llvm::object::OwningBinary<llvm::object::ObjectFile>> OwnedObjectFiles;
+
+protected:
+  typedef llvm::orc::ObjectLinkingLayer<> ObjectLayerType;
+
+  llvm::TargetMachine &machine;
+  ObjectLayerType ObjectLayer;
+
+private:
+  /// Every object file is linked as a separate object set. The sets stay in
+  /// the layer between runs and are finalized (loaded and relocated) lazily,
+  /// only once some symbol of theirs is needed.
+  std::map<llvm::object::ObjectFile *, ObjectLayerType::ObjSetHandleT> LinkedObjects;
+  /// Handles are list iterators, hence the sets are looked up by the
+  /// address of the list element
+  std::map<const void *, llvm::object::ObjectFile *> LinkedHandles;
+  std::vector<llvm::object::ObjectFile *> FinalizedObjects;
+  /// Finalized sets that hold the initial state of the program rather than
+  /// the state of a run, see keepFinalizedObjects
+  std::set<llvm::object::ObjectFile *> InitialStateObjects;
+
+public:
   TestRunner(llvm::TargetMachine &targetMachine);
 
+  /// Makes the runner's program consist of exactly the given object files.
+  ///
+  /// Object files which are already linked and not yet finalized are kept
+  /// as is, the ones missing from the list are unlinked. A finalized set has
+  /// its relocations bound to the code of the other sets, so once anything
+  /// is unlinked all the finalized sets are unlinked as well and linked
+  /// again. Sets finalized by an earlier run in this process carry the state
+  /// of that run and are unlinked the same way.
+  ///
+  /// The Driver links the original program once, before forking, so the
+  /// forked runs only pay for adding the mutated module and for finalizing
+  /// the modules the test reaches. Finalization is never shared between
+  /// runs: the parent process does not finalize anything, except for the
+  /// initial state kept by initializeProgram.
+  ///
+  /// Object files are referenced, not copied: they must stay alive while
+  /// they are part of the program.
+  ///
+  /// Returns true if the program has changed.
+  bool loadProgram(ObjectFiles &objectFiles);
+
+  /// Runs the one-time initialization of the loaded program (e.g. static
+  /// constructors) in the current process, so that the processes forked
+  /// afterwards start from the initialized state and runTest skips it as
+  /// long as the program stays the same. Does nothing by default.
+  virtual void initializeProgram(Test *Test) {}
+
   virtual ExecutionResult runTest(Test *Test, ObjectFiles &ObjectFiles) = 0;
 
   virtual ~TestRunner() {}
+
+protected:
+  /// Resolver for the symbols a single object set does not define itself.
+  /// Implementations should look into the ObjectLayer first so that
+  /// references between modules of the program are resolved lazily.
+  virtual std::unique_ptr<llvm::JITSymbolResolver>
+  createResolver(llvm::object::ObjectFile *objectFile) = 0;
+
+  /// Called right before the object files are unlinked, while all of them
+  /// are still in place.
+  virtual void
+  willUnloadObjectFiles(const std::vector<llvm::object::ObjectFile *> &objectFiles) {}
+
+  /// Marks the sets finalized so far as the initial state of the program,
+  /// loadProgram keeps them while the program stays the same.
+  void keepFinalizedObjects();
+
+private:
+  void unloadObjectFiles(const std::vector<llvm::object::ObjectFile *> &objectFiles);
 };
 
 }
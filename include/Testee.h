@@ -1,6 +1,7 @@
 #pragma once
 
 #include "llvm/IR/Function.h"
+#include "llvm/Support/Allocator.h"
 
 namespace Mutang {
 
@@ -36,4 +37,24 @@ public:
   }
 };
 
+/// Owns all the Testees found during a run.
+///
+/// Testees are bump-allocated, so walking a call graph does not pay for a
+/// malloc per node, and keep stable addresses until the arena is destroyed:
+/// callers, mutation results and Result refer to them by plain pointers.
+class TesteeArena {
+  llvm::SpecificBumpPtrAllocator<Testee> allocator;
+
+public:
+  Testee *create(llvm::Function *testeeFunction,
+                 llvm::Instruction *callerInstruction,
+                 Testee *callerTestee,
+                 int distance) {
+    return new (allocator.Allocate()) Testee(testeeFunction,
+                                             callerInstruction,
+                                             callerTestee,
+                                             distance);
+  }
+};
+
 }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+namespace Mutang {
+
+class Config;
+
+/// Decides how long a mutant may run based on how long the original
+/// test took.
+///
+/// The running times of several runs of the original test are summarized
+/// as their median plus two standard deviations, so that a single slow run
+/// does not inflate the budget while a noisy test still gets some slack.
+/// The result is multiplied and clamped between a floor, which covers
+/// sub-millisecond tests and the fixed cost of a sandbox, and a ceiling,
+/// which bounds the time spent on mutants stuck in infinite loops.
+class TimeoutPolicy {
+  double multiplier;
+  long long minimumTimeout;
+  long long maximumTimeout;
+
+public:
+  TimeoutPolicy(double multiplier,
+                long long minimumTimeoutMilliseconds,
+                long long maximumTimeoutMilliseconds);
+  explicit TimeoutPolicy(const Config &config);
+
+  /// Running times are in microseconds (see ExecutionResult::RunningTime),
+  /// the timeout is in milliseconds as expected by ProcessSandbox
+  long long timeoutFor(const std::vector<long long> &runningTimes) const;
+};
+
+}
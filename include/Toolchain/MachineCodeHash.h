@@ -0,0 +1,21 @@
+#pragma once
+
+#include "llvm/Object/ObjectFile.h"
+
+#include <string>
+
+namespace Mutang {
+
+/// Hashes the machine code emitted for a single function.
+///
+/// The hash covers the bytes of the function along with its relocations,
+/// so that calls to different functions or loads of different constants
+/// are not mistaken for the same code. Two mutants of the same function
+/// with equal hashes behave the same way, as the rest of the module is
+/// compiled from the same IR.
+///
+/// Returns an empty string if the function is not found in the object.
+std::string hashFunctionCode(const llvm::object::ObjectFile &object,
+                             llvm::StringRef functionName);
+
+}
@@ -26,11 +26,13 @@ namespace Mutang {
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
                    const MutationPoint &mutationPoint);
 
-  private:
+    /// For objects that are neither plain modules nor plain mutants
     llvm::object::ObjectFile *getObject(const std::string &identifier);
     void putObject(llvm::object::OwningBinary<llvm::object::ObjectFile> object,
                    const std::string &identifier);
 
+  private:
+
     llvm::object::ObjectFile *getObjectFromMemory(const std::string &identifier);
     llvm::object::ObjectFile *getObjectFromDisk(const std::string &identifier);
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ExecutionEngine/JITSymbol.h"
+#include "llvm/Object/ObjectFile.h"
+
+#include <atomic>
+#include <string>
+
+namespace Mutang {
+
+  /// Addresses of the symbols provided by the host process (libc, libc++,
+  /// hooks of the test runners) to the JIT-ed code.
+  ///
+  /// Looking a symbol up in the process walks every loaded library, so each
+  /// name is looked up only once and the result, including a failed lookup,
+  /// is kept in a hash table.
+  ///
+  /// There is one cache per process, shared by all the runners. The parent
+  /// fills it while linking the program, before any sandbox is forked, so
+  /// forked children inherit the table. Hit and miss counters live in shared
+  /// memory and account for the lookups made by the children as well.
+  class ProcessSymbolCache {
+    struct Counters {
+      std::atomic<uint64_t> hits;
+      std::atomic<uint64_t> misses;
+    };
+
+    llvm::StringMap<uint64_t> addresses;
+    Counters *counters;
+
+    ProcessSymbolCache();
+  public:
+    ProcessSymbolCache(const ProcessSymbolCache &) = delete;
+    ProcessSymbolCache &operator=(const ProcessSymbolCache &) = delete;
+
+    static ProcessSymbolCache &shared();
+
+    llvm::JITSymbol findSymbol(const std::string &name);
+
+    /// Looks up all the symbols the object file expects from outside
+    void prefetch(const llvm::object::ObjectFile &objectFile);
+
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    void resetCounters();
+  };
+}
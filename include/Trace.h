@@ -0,0 +1,102 @@
+#pragma once
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace Mutang {
+
+  /// Time spent in the phases of a run: loading and compiling modules,
+  /// finding tests, testees and mutation points, compiling mutants, linking
+  /// and running them.
+  ///
+  /// Every span goes to a Chrome trace (chrome://tracing, Perfetto) and to
+  /// a summary table with the totals per phase.
+  ///
+  /// There is one trace per process. Spans recorded in forked children, such
+  /// as the linking done by the runner inside the sandbox, cannot reach the
+  /// parent's list. Their durations are added to totals kept in shared
+  /// memory instead, so they still show up in the summary.
+  class Trace {
+  public:
+    struct Span {
+      std::string name;
+      std::string category;
+      std::string detail;
+      /// Microseconds since tracing was enabled
+      long long start;
+      long long duration;
+    };
+
+  private:
+    struct SharedPhase {
+      std::atomic<bool> ready;
+      char name[64];
+      std::atomic<uint64_t> count;
+      std::atomic<uint64_t> total;
+    };
+
+    struct SharedPhases {
+      std::atomic<int> size;
+      SharedPhase phases[32];
+    };
+
+    bool enabled;
+    pid_t ownerPID;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Span> spans;
+    SharedPhases *sharedPhases;
+
+    Trace();
+
+    void addSharedSpan(const std::string &name, long long duration);
+  public:
+    Trace(const Trace &) = delete;
+    Trace &operator=(const Trace &) = delete;
+
+    static Trace &shared();
+
+    /// Enabling the trace clears it and starts the clock
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    /// Microseconds since tracing was enabled
+    long long now() const;
+
+    void addSpan(const std::string &name,
+                 const std::string &category,
+                 long long start,
+                 long long duration,
+                 const std::string &detail = "");
+
+    const std::vector<Span> &getSpans() const { return spans; }
+
+    /// Returns false if the file cannot be written
+    bool writeChromeTrace(const std::string &path) const;
+
+    /// Count, total and mean duration of each phase, longest total first
+    void printSummary(llvm::raw_ostream &out) const;
+  };
+
+  /// Records a span from construction to destruction, costs nothing
+  /// when tracing is disabled
+  class TraceScope {
+    const char *name;
+    const char *category;
+    std::string detail;
+    long long start;
+
+  public:
+    TraceScope(const char *name,
+               const char *category,
+               const std::string &detail = "");
+    ~TraceScope();
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+  };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "TestResult.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mutang {
+
+/// Coordinator and workers talk over a Unix domain socket.
+///
+/// A worker connects and sends Ready. The coordinator answers with a Job or,
+/// once the queue is empty, with Done. The worker runs the job and sends its
+/// Result, which also asks for the next job.
+///
+/// A message is a list of fields, each field is prefixed with its length,
+/// so the output of the tests goes through as is.
+namespace WorkerMessage {
+  const char *const Ready = "ready";
+  const char *const Job = "job";
+  const char *const Result = "result";
+  const char *const Done = "done";
+}
+
+/// A mutant to run against a test. Tests and mutation points are referred to
+/// by name and unique identifier: every worker finds them in its own Context
+struct WorkerJob {
+  uint64_t id;
+  std::string testName;
+  std::string mutationPoint;
+  long long timeout;
+  uint64_t iterationBudget;
+};
+
+class WorkerChannel {
+  int fileDescriptor;
+
+public:
+  /// A peer sending more or longer fields than these is treated as gone,
+  /// rather than trusted with the memory to allocate. The output of a test
+  /// is cut to fit.
+  static const uint32_t MaxFields = 16;
+  static const uint32_t MaxFieldLength = 64 * 1024 * 1024;
+
+  explicit WorkerChannel(int fileDescriptor);
+  ~WorkerChannel();
+
+  WorkerChannel(const WorkerChannel &) = delete;
+  WorkerChannel &operator=(const WorkerChannel &) = delete;
+
+  int getFileDescriptor() const { return fileDescriptor; }
+
+  /// Both return false once the other side is gone
+  bool send(const std::vector<std::string> &fields);
+  bool receive(std::vector<std::string> &fields);
+
+  bool sendJob(const WorkerJob &job);
+  bool sendResult(uint64_t jobId, const ExecutionResult &result);
+
+  /// Return false if the message is not of the expected kind
+  static bool decodeJob(const std::vector<std::string> &fields, WorkerJob &job);
+  static bool decodeResult(const std::vector<std::string> &fields,
+                           uint64_t &jobId,
+                           ExecutionResult &result);
+
+  /// Return a file descriptor, or -1 after logging the error
+  static int listenOn(const std::string &socketPath, int backlog);
+  static int connectTo(const std::string &socketPath);
+};
+
+}
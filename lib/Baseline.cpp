@@ -0,0 +1,101 @@
+#include "Baseline.h"
+
+#include "Logger.h"
+
+#include <sqlite3.h>
+
+using namespace Mutang;
+
+/// Test and mutation point hashes appeared in version 3 of the schema,
+/// resource usage in version 4
+static const int MinimumSchemaVersion = 4;
+
+static const char *SelectResults = R"SelectResults(
+SELECT test.test_name, test.testees_hash, mutation_point.stable_id,
+       execution_result.status, execution_result.duration,
+       execution_result.stdout, execution_result.stderr,
+       execution_result.user_time, execution_result.system_time,
+       execution_result.max_rss, execution_result.major_faults,
+       execution_result.minor_faults, execution_result.context_switches
+FROM mutation_result
+JOIN test ON test.id = mutation_result.test_id
+JOIN mutation_point ON mutation_point.id = mutation_result.mutation_point_id
+JOIN execution_result ON execution_result.rowid = mutation_result.execution_result_id;
+)SelectResults";
+
+static std::string columnText(sqlite3_stmt *statement, int column) {
+  const unsigned char *text = sqlite3_column_text(statement, column);
+  return text ? reinterpret_cast<const char *>(text) : "";
+}
+
+std::string Baseline::key(const std::string &testName,
+                          const std::string &testeesHash,
+                          const std::string &mutationPointIdentifier) {
+  return testName + "\n" + testeesHash + "\n" + mutationPointIdentifier;
+}
+
+bool Baseline::load(const std::string &databasePath) {
+  sqlite3 *database;
+  if (sqlite3_open_v2(databasePath.c_str(), &database,
+                      SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+    Logger::error() << "Cannot open baseline '" << databasePath << "'\n";
+    sqlite3_close(database);
+    return false;
+  }
+
+  sqlite3_stmt *statement = nullptr;
+  int version = 0;
+  if (sqlite3_prepare_v2(database, "SELECT version FROM schema_version;",
+                         -1, &statement, nullptr) == SQLITE_OK &&
+      sqlite3_step(statement) == SQLITE_ROW) {
+    version = sqlite3_column_int(statement, 0);
+  }
+  sqlite3_finalize(statement);
+
+  if (version < MinimumSchemaVersion) {
+    Logger::error() << "Baseline '" << databasePath << "' has schema version "
+                    << version << ", at least " << MinimumSchemaVersion
+                    << " is needed\n";
+    sqlite3_close(database);
+    return false;
+  }
+
+  if (sqlite3_prepare_v2(database, SelectResults, -1, &statement, nullptr) != SQLITE_OK) {
+    Logger::error() << "Cannot read baseline '" << databasePath << "': "
+                    << sqlite3_errmsg(database) << "\n";
+    sqlite3_close(database);
+    return false;
+  }
+
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    ExecutionResult result;
+    result.Status = ExecutionStatus(sqlite3_column_int(statement, 3));
+    result.RunningTime = sqlite3_column_int64(statement, 4);
+    result.stdoutOutput = columnText(statement, 5);
+    result.stderrOutput = columnText(statement, 6);
+    result.Usage.UserTime = sqlite3_column_int64(statement, 7);
+    result.Usage.SystemTime = sqlite3_column_int64(statement, 8);
+    result.Usage.MaxRSS = sqlite3_column_int64(statement, 9);
+    result.Usage.MajorFaults = sqlite3_column_int64(statement, 10);
+    result.Usage.MinorFaults = sqlite3_column_int64(statement, 11);
+    result.Usage.ContextSwitches = sqlite3_column_int64(statement, 12);
+
+    results[key(columnText(statement, 0),
+                columnText(statement, 1),
+                columnText(statement, 2))] = result;
+  }
+
+  sqlite3_finalize(statement);
+  sqlite3_close(database);
+  return true;
+}
+
+const ExecutionResult *Baseline::findResult(const std::string &testName,
+                                            const std::string &testeesHash,
+                                            const std::string &mutationPointIdentifier) const {
+  auto result = results.find(key(testName, testeesHash, mutationPointIdentifier));
+  if (result == results.end()) {
+    return nullptr;
+  }
+  return &result->second;
+}
@@ -7,6 +7,7 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/YAMLParser.h"
 
+#include <cstdlib>
 #include <memory>
 
 using namespace llvm;
@@ -37,3 +38,9 @@ Config ConfigParser::loadConfig(yaml::Input &input) {
   input >> config;
   return config;
 }
+
+void Mutang::configurationError(const Twine &message) {
+  Logger::error() << "Invalid configuration: " << message << '\n';
+  Logger::error().flush();
+  exit(ConfigurationErrorExitCode);
+}
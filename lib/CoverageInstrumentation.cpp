@@ -0,0 +1,118 @@
+#include "CoverageInstrumentation.h"
+
+#include "MutationPoint.h"
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instruction.h"
+
+#include <cstring>
+#include <sys/mman.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+/// Instrumented code refers to the marks through this pointer,
+/// JIT resolves it to the host process
+extern "C" uint8_t *mutang_coverage_marks = nullptr;
+
+CoverageInstrumentation::CoverageInstrumentation()
+  : marks(nullptr), marksSize(0) {}
+
+CoverageInstrumentation::~CoverageInstrumentation() {
+  if (marks == nullptr) {
+    return;
+  }
+
+  if (mutang_coverage_marks == marks) {
+    mutang_coverage_marks = nullptr;
+  }
+
+  munmap(marks, marksSize);
+}
+
+void CoverageInstrumentation::instrument(Module &original, Module &clone) {
+  LLVMContext &context = clone.getContext();
+  Type *markType = Type::getInt8Ty(context);
+  Constant *marksPointer =
+    clone.getOrInsertGlobal("mutang_coverage_marks", Type::getInt8PtrTy(context));
+
+  /// The clone has exactly the same layout as the original module,
+  /// hence the blocks can be matched by walking both modules at once
+  auto originalFunction = original.begin();
+  for (auto &function : clone) {
+    Function &originalLLVMFunction = *originalFunction++;
+    if (function.isDeclaration()) {
+      continue;
+    }
+
+    auto originalBlock = originalLLVMFunction.begin();
+    for (auto &block : function) {
+      BasicBlock *originalBasicBlock = &*originalBlock++;
+
+      auto insertionPoint = block.getFirstInsertionPt();
+      if (insertionPoint == block.end()) {
+        continue;
+      }
+
+      unsigned index = blocks.size();
+      blocks.push_back(originalBasicBlock);
+      blockIndices[originalBasicBlock] = index;
+
+      IRBuilder<> builder(&*insertionPoint);
+      Value *base = builder.CreateLoad(marksPointer);
+      Value *mark = builder.CreateConstGEP1_32(base, index);
+      builder.CreateStore(ConstantInt::get(markType, 1), mark);
+    }
+  }
+}
+
+void CoverageInstrumentation::allocateMarks() {
+  assert(marks == nullptr && "Marks are already allocated");
+
+  /// mmap does not accept zero length
+  marksSize = blocks.size() + 1;
+  void *sharedMemory = mmap(NULL,
+                            marksSize,
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS,
+                            -1,
+                            0);
+  assert(sharedMemory != MAP_FAILED && "Can't map memory for coverage");
+
+  marks = static_cast<uint8_t *>(sharedMemory);
+  mutang_coverage_marks = marks;
+  resetMarks();
+}
+
+void CoverageInstrumentation::resetMarks() {
+  memset(marks, 0, marksSize);
+}
+
+BitVector CoverageInstrumentation::collectCoverage() const {
+  BitVector coverage(blocks.size());
+
+  for (unsigned index = 0; index < blocks.size(); index++) {
+    if (marks[index]) {
+      coverage.set(index);
+    }
+  }
+
+  return coverage;
+}
+
+bool CoverageInstrumentation::isCovered(const BitVector &coverage,
+                                        MutationPoint *mutationPoint) const {
+  auto instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
+  if (!instruction) {
+    return true;
+  }
+
+  auto index = blockIndices.find(instruction->getParent());
+  if (index == blockIndices.end()) {
+    return true;
+  }
+
+  return coverage.test(index->second);
+}
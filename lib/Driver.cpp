@@ -2,10 +2,13 @@
 
 #include "Config.h"
 #include "Context.h"
+#include "CoverageInstrumentation.h"
+#include "LoopBudget.h"
 #include "Logger.h"
 #include "ModuleLoader.h"
 #include "Result.h"
 #include "TestResult.h"
+#include "Trace.h"
 
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Module.h"
@@ -18,13 +21,17 @@
 
 #include "TestFinder.h"
 #include "TestRunner.h"
-
-/// FIXME: Should be abstract
-#include "MutationOperators/AddMutationOperator.h"
+#include "Toolchain/MachineCodeHash.h"
+#include "Toolchain/ProcessSymbolCache.h"
 
 #include <algorithm>
 #include <chrono>
+#include <deque>
 #include <fstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <vector>
 
 using namespace llvm;
@@ -52,47 +59,149 @@ using namespace std::chrono;
 
 std::unique_ptr<Result> Driver::Run() {
   std::vector<std::unique_ptr<TestResult>> Results;
-  std::vector<std::unique_ptr<Testee>> allTestees;
+  std::vector<Testee *> allTestees;
 
-  /// Assumption: all modules will be used during the execution
-  /// Therefore we load them into memory and compile immediately
-  /// Later on modules used only for generating of mutants
-  for (auto ModulePath : Cfg.getBitcodePaths()) {
-    unique_ptr<MutangModule> ownedModule = Loader.loadModuleAtPath(ModulePath);
-    MutangModule &module = *ownedModule.get();
-    assert(ownedModule && "Can't load module");
+  auto ObjectFiles = LoadProgram();
 
-    ObjectFile *objectFile = toolchain.cache().getObject(module);
+  /// Coverage pruning and loop budgets observe the unmutated run of each
+  /// test, so that run is made against instrumented copies of the modules.
+  ///
+  /// With coverage pruning the mutants in the basic blocks the test did not
+  /// execute are not run: they would survive anyway.
+  /// With loop budgets a mutant exits as soon as the loops of the mutated
+  /// function run much longer than they did in the unmutated run.
+  const bool useLoopBudget = Cfg.isLoopBudgetEnabled() && Cfg.getFork();
+  if (Cfg.isLoopBudgetEnabled() && !Cfg.getFork()) {
+    Logger::warn() << "loop budget requires fork, ignoring it\n";
+  }
 
-    if (objectFile == nullptr) {
-      auto owningObjectFile = toolchain.compiler().compileModule(*module.clone().get());
-      objectFile = owningObjectFile.getBinary();
-      toolchain.cache().putObject(std::move(owningObjectFile), *ownedModule.get());
-    }
+  /// Mutant-centric mode stops at the first test killing a mutant,
+  /// which does not split into independent jobs
+  const bool useWorkers = Cfg.getWorkers() > 0 && !Cfg.isMutantCentric();
+  if (Cfg.getWorkers() > 0 && Cfg.isMutantCentric()) {
+    Logger::warn() << "workers do not support mutant-centric mode, ignoring them\n";
+  }
 
-    InnerCache.insert(std::make_pair(module.getModule(), objectFile));
-    Ctx.addModule(std::move(ownedModule));
+  std::vector<ObjectFile *> InstrumentedObjectFiles;
+  if (Cfg.isCoveragePruningEnabled() || useLoopBudget) {
+    TraceScope scope("instrument program", "compile");
+    InstrumentedObjectFiles = InstrumentProgram(Cfg.isCoveragePruningEnabled(),
+                                                useLoopBudget);
   }
 
-  auto foundTests = Finder.findTests(Ctx);
+  /// In incremental mode the results of the mutants that could not change
+  /// since the baseline run are taken from its database
+  if (!Cfg.getBaselineDatabase().empty() &&
+      baseline.load(Cfg.getBaselineDatabase())) {
+    Logger::info() << "Loaded " << baseline.size() << " results from baseline '"
+                   << Cfg.getBaselineDatabase() << "'\n";
+  }
+
+  std::vector<std::unique_ptr<Test>> foundTests;
+  {
+    TraceScope scope("find tests", "discovery");
+    foundTests = Finder.findTests(Ctx);
+  }
+
+  /// In zygote mode the global initialization happens here, once, and each
+  /// forked test only applies its filter and runs its body. The state must
+  /// stay in the parent, therefore this only works when tests are forked
+  if (Cfg.getZygote() && !foundTests.empty()) {
+    if (Cfg.getFork()) {
+      Runner.initializeProgram(foundTests.front().get());
+      if (!InstrumentedObjectFiles.empty()) {
+        Logger::warn() << "zygote mode has no effect on the instrumented runs "
+                          "of coverage pruning and loop budget\n";
+      }
+    } else {
+      Logger::warn() << "zygote mode requires fork, ignoring it\n";
+    }
+  }
 
   // Logger::info() << "Driver::Run::begin with " << foundTests.size() << "
   // tests\n";
 
   for (auto &test : foundTests) {
-    auto ObjectFiles = AllObjectFiles();
-
     // Logger::info() << "\tDriver::Run::run test: " << test->getTestName() <<
     // "\n";
 
-    ExecutionResult ExecResult = Sandbox->run([&](ExecutionResult *SharedResult) {
-      *SharedResult = Runner.runTest(test.get(), ObjectFiles);
-    }, Cfg.getTimeout());
+    const bool instrumented = !InstrumentedObjectFiles.empty();
+    auto &OriginalProgram = instrumented ? InstrumentedObjectFiles : ObjectFiles;
+    if (coverage) {
+      coverage->resetMarks();
+    }
+    if (loopBudget) {
+      loopBudget->resetCounters();
+    }
+
+    ExecutionResult ExecResult;
+    {
+      TraceScope scope("run test", "run", test->getTestName());
+      ExecResult = Sandbox->run([&](ExecutionResult *SharedResult) {
+        *SharedResult = Runner.runTest(test.get(), OriginalProgram);
+      }, Cfg.getTimeout());
+    }
+
+    BitVector testCoverage;
+    if (coverage) {
+      testCoverage = coverage->collectCoverage();
+    }
+
+    std::vector<uint64_t> LoopCounts;
+    if (loopBudget) {
+      LoopCounts = loopBudget->collectCounts();
+    }
+
+    /// The mutant timeout is based on several runs of the original test.
+    /// The instrumented program is slower, so it does not count
+    std::vector<long long> RunningTimes;
+    if (!instrumented) {
+      RunningTimes.push_back(ExecResult.RunningTime);
+    }
+
+    if (ExecResult.Status == ExecutionStatus::Passed) {
+      const size_t samples = std::max(1, Cfg.getTimingSamples());
+      while (RunningTimes.size() < samples) {
+        TraceScope scope("sample test", "run", test->getTestName());
+        ExecutionResult Sample = Sandbox->run([&](ExecutionResult *SharedResult) {
+          *SharedResult = Runner.runTest(test.get(), ObjectFiles);
+        }, Cfg.getTimeout());
+
+        if (Sample.Status != ExecutionStatus::Passed) {
+          break;
+        }
+        RunningTimes.push_back(Sample.RunningTime);
+      }
+    }
+
+    if (RunningTimes.empty()) {
+      RunningTimes.push_back(ExecResult.RunningTime);
+    }
+
+    const long long MutantTimeout = timeoutPolicy.timeoutFor(RunningTimes);
 
     auto BorrowedTest = test.get();
     auto Result = make_unique<TestResult>(ExecResult, std::move(test));
 
-    auto testees = Finder.findTestees(BorrowedTest, Ctx, Cfg.getMaxDistance());
+    std::vector<Testee *> testees;
+    {
+      TraceScope scope("find testees", "discovery", BorrowedTest->getTestName());
+      testees = Finder.findTestees(BorrowedTest, Ctx, Cfg.getMaxDistance());
+    }
+
+    const std::string TesteesHash = functionHasher.hashReachableCode(*testees.front()->getTesteeFunction(), Ctx);
+    Result->setTesteesHash(TesteesHash);
+
+    /// The static size of the code a test reaches stands for the cost of
+    /// its mutants: unlike running times it is the same on every shard
+    uint64_t TestCost = 0;
+    if (shardPlanner.isSharded()) {
+      for (auto testee : testees) {
+        for (auto &basicBlock : *testee->getTesteeFunction()) {
+          TestCost += basicBlock.size();
+        }
+      }
+    }
 
     // Logger::info() << "\tagainst " << testees.size() << " testees\n";
 
@@ -100,18 +209,65 @@ std::unique_ptr<Result> Driver::Run() {
          testee_it != ee;
          ++testee_it) {
 
-      auto &&testee = *testee_it;
+      Testee *testee = *testee_it;
 
-      auto MPoints = Finder.findMutationPoints(Ctx, *(testee->getTesteeFunction()));
+      if (functionFilter.shouldSkipFunction(*testee->getTesteeFunction())) {
+        continue;
+      }
+
+      std::vector<MutationPoint *> MPoints;
+      {
+        TraceScope scope("find mutation points", "discovery");
+        MPoints = Finder.findMutationPoints(Ctx, *(testee->getTesteeFunction()));
+      }
+      if (Cfg.isEquivalentMutantPruningEnabled()) {
+        TraceScope scope("prune equivalent mutants", "discovery");
+        MPoints = equivalentMutantFilter.filter(MPoints);
+      }
+      if (shardPlanner.isSharded()) {
+        MPoints = OwnMutationPoints(MPoints, BorrowedTest, TestCost);
+      }
       if (MPoints.empty()) {
         continue;
       }
 
+      uint64_t IterationBudget = 0;
+      if (loopBudget) {
+        IterationBudget = loopBudget->budgetFor(LoopCounts,
+                                                testee->getTesteeFunction());
+      }
+
       // Logger::info() << "\t\tDriver::Run::process testee: " <<
       // testee.first->getName() << "\n";
       // Logger::info() << "\t\tagainst " << MPoints.size() << " mutation
       // points\n";
 
+      /// In mutant-centric mode the mutants are not run right away: they are
+      /// collected along with all the tests reaching them and run once every
+      /// test is known, see runMutantsByKillLikelihood. A test failing on its
+      /// own cannot tell anything about mutants
+      if (Cfg.isMutantCentric()) {
+        if (ExecResult.Status == ExecutionStatus::Passed) {
+          for (auto mutationPoint : MPoints) {
+            if (coverage && !coverage->isCovered(testCoverage, mutationPoint)) {
+              Result->addMutantResult(make_unique<MutationResult>(NotCoveredResult(),
+                                                                  mutationPoint,
+                                                                  testee));
+              continue;
+            }
+            if (auto carried = baselineResult(BorrowedTest, TesteesHash, mutationPoint)) {
+              Result->addMutantResult(make_unique<MutationResult>(*carried,
+                                                                  mutationPoint,
+                                                                  testee));
+              continue;
+            }
+            addKillerCandidate(mutationPoint, Result.get(), BorrowedTest, testee,
+                               MutantTimeout, IterationBudget);
+          }
+        }
+        continue;
+      }
+
       auto ObjectFiles = AllButOne(testee->getTesteeFunction()->getParent());
       for (auto mutationPoint : MPoints) {
         //        Logger::info() << "\t\t\tDriver::Run::run mutant:" << "\t";
@@ -119,50 +275,681 @@ std::unique_ptr<Result> Driver::Run() {
         //        Logger::info() << "\n";
 
         ExecutionResult result;
-        bool dryRun = Cfg.isDryRun();
-        if (dryRun) {
-          result.Status = DryRun;
-          result.RunningTime = ExecResult.RunningTime * 10;
+        if (coverage && !coverage->isCovered(testCoverage, mutationPoint)) {
+          result = NotCoveredResult();
+        } else if (auto carried = baselineResult(BorrowedTest, TesteesHash, mutationPoint)) {
+          result = *carried;
+        } else if (useWorkers) {
+          remoteJobs.push_back({ mutationPoint,
+                                 { Result.get(), BorrowedTest, testee,
+                                   MutantTimeout, IterationBudget } });
+          continue;
         } else {
-          ObjectFile *mutant = toolchain.cache().getObject(*mutationPoint);
-          if (mutant == nullptr) {
-            auto owningObject = mutationPoint->applyMutation(toolchain.compiler());
-            mutant = owningObject.getBinary();
-            toolchain.cache().putObject(std::move(owningObject), *mutationPoint);
-          }
-          ObjectFiles.push_back(mutant);
-
-          result = Sandbox->run([&](ExecutionResult *SharedResult) {
-            ExecutionResult R = Runner.runTest(BorrowedTest, ObjectFiles);
-
-            assert(R.Status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
-
-            *SharedResult = R;
-          }, ExecResult.RunningTime * 10);
-          ObjectFiles.pop_back();
-
-          assert(result.Status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+          result = runMutant(mutationPoint, BorrowedTest, ObjectFiles,
+                             MutantTimeout, IterationBudget);
         }
 
-        auto MutResult = make_unique<MutationResult>(result, mutationPoint, testee.get());
+        auto MutResult = make_unique<MutationResult>(result, mutationPoint, testee);
         Result->addMutantResult(std::move(MutResult));
       }
     }
 
-    allTestees.insert(allTestees.end(),std::make_move_iterator(testees.begin()),
-                      std::make_move_iterator(testees.end()));
+    allTestees.insert(allTestees.end(), testees.begin(), testees.end());
 
     Results.push_back(std::move(Result));
   }
 
+  if (Cfg.isMutantCentric()) {
+    runMutantsByKillLikelihood();
+  }
+
+  if (!remoteJobs.empty()) {
+    runJobsOnWorkers();
+  }
+
   //  Logger::info() << "Driver::Run::end\n";
 
+  if (Cfg.isEquivalentMutantPruningEnabled()) {
+    Logger::info() << "Pruned " << equivalentMutantFilter.getEquivalentCount()
+                   << " equivalent and "
+                   << equivalentMutantFilter.getRedundantCount()
+                   << " redundant mutants\n";
+  }
+
+  if (Cfg.isTrivialCompilerEquivalenceEnabled()) {
+    Logger::info() << equivalentCodeMutants
+                   << " mutants compiled to the original code, "
+                   << duplicateCodeMutants
+                   << " runs reused the result of identical code\n";
+  }
+
+  if (baseline.size() != 0) {
+    Logger::info() << carriedResults << " mutant results carried over from baseline\n";
+  }
+
+  ProcessSymbolCache &symbolCache = ProcessSymbolCache::shared();
+  Logger::debug() << "Process symbol cache: " << symbolCache.getHits()
+                  << " hits, " << symbolCache.getMisses() << " misses\n";
+
   std::unique_ptr<Result> result = make_unique<Result>(std::move(Results),
                                                        std::move(allTestees));
 
   return result;
 }
 
+std::vector<ObjectFile *> Driver::LoadProgram() {
+  /// Assumption: all modules will be used during the execution
+  /// Therefore we load them into memory and compile immediately
+  /// Later on modules used only for generating of mutants
+  for (auto ModulePath : Cfg.getBitcodePaths()) {
+    unique_ptr<MutangModule> ownedModule;
+    {
+      TraceScope scope("load module", "load", ModulePath);
+      ownedModule = Loader.loadModuleAtPath(ModulePath);
+    }
+    MutangModule &module = *ownedModule.get();
+    assert(ownedModule && "Can't load module");
+
+    ObjectFile *objectFile = toolchain.cache().getObject(module);
+
+    if (objectFile == nullptr) {
+      TraceScope scope("compile module", "compile", ModulePath);
+      auto owningObjectFile = toolchain.compiler().compileModule(*module.clone().get());
+      objectFile = owningObjectFile.getBinary();
+      toolchain.cache().putObject(std::move(owningObjectFile), *ownedModule.get());
+    }
+
+    InnerCache.insert(std::make_pair(module.getModule(), objectFile));
+    Ctx.addModule(std::move(ownedModule));
+  }
+
+  /// The original program is linked once, outside of the sandbox, so that
+  /// every forked run starts with all the object sets already added. Each
+  /// run still finalizes the modules its test reaches, see loadProgram
+  auto ObjectFiles = AllObjectFiles();
+  {
+    TraceScope scope("link program", "jit");
+    Runner.loadProgram(ObjectFiles);
+  }
+
+  return ObjectFiles;
+}
+
+std::vector<ObjectFile *> Driver::InstrumentProgram(bool withCoverage,
+                                                    bool withLoopBudget) {
+  if (withCoverage) {
+    coverage = make_unique<CoverageInstrumentation>();
+  }
+  if (withLoopBudget) {
+    loopBudget = make_unique<LoopBudget>(Cfg.getLoopBudgetMultiplier());
+  }
+
+  std::vector<ObjectFile *> Objects;
+  for (auto &CachedEntry : InnerCache) {
+    Module &original = *CachedEntry.first;
+    auto instrumentedModule = CloneModule(&original);
+
+    if (coverage) {
+      coverage->instrument(original, *instrumentedModule);
+    }
+    if (loopBudget) {
+      loopBudget->instrumentCounters(original, *instrumentedModule);
+    }
+
+    auto owningObjectFile = toolchain.compiler().compileModule(instrumentedModule.get());
+    Objects.push_back(owningObjectFile.getBinary());
+    InstrumentedObjects.push_back(std::move(owningObjectFile));
+  }
+
+  if (coverage) {
+    coverage->allocateMarks();
+  }
+  if (loopBudget) {
+    loopBudget->allocateCounters();
+  }
+
+  return Objects;
+}
+
+ExecutionResult Driver::NotCoveredResult() {
+  ExecutionResult result;
+  result.Status = ExecutionStatus::NotCovered;
+  result.RunningTime = 0;
+  return result;
+}
+
+static StringRef mutatedFunctionName(MutationPoint *mutationPoint) {
+  Module *module = mutationPoint->getOriginalModule()->getModule();
+  int functionIndex = mutationPoint->getAddress().getFnIndex();
+  return std::next(module->begin(), functionIndex)->getName();
+}
+
+static std::tuple<Test *, std::string, std::string, std::string>
+functionCodeKey(Test *test, MutationPoint *mutationPoint, const std::string &code) {
+  return std::make_tuple(test,
+                         mutationPoint->getOriginalModule()->getUniqueIdentifier(),
+                         mutatedFunctionName(mutationPoint).str(),
+                         code);
+}
+
+ExecutionResult Driver::runMutant(MutationPoint *mutationPoint,
+                                  Test *test,
+                                  std::vector<ObjectFile *> &objectFiles,
+                                  long long timeout,
+                                  uint64_t iterationBudget) {
+  ExecutionResult result;
+
+  if (Cfg.isDryRun()) {
+    result.Status = DryRun;
+    result.RunningTime = timeout * 1000;
+    return result;
+  }
+
+  ObjectFile *mutant = nullptr;
+
+  /// A mutant whose function compiles to the same code as the original one
+  /// cannot be killed, and a mutant compiling to the same code as another
+  /// one gets the same result
+  std::string mutantCode;
+  if (Cfg.isTrivialCompilerEquivalenceEnabled()) {
+    mutant = compileMutant(mutationPoint);
+    mutantCode = functionCodeHash(mutant, mutationPoint);
+
+    Module *original = mutationPoint->getOriginalModule()->getModule();
+    if (!mutantCode.empty() &&
+        mutantCode == functionCodeHash(InnerCache.at(original), mutationPoint)) {
+      equivalentCodeMutants++;
+      result.Status = ExecutionStatus::Equivalent;
+      result.RunningTime = 0;
+      return result;
+    }
+
+    auto known = resultsByFunctionCode.find(functionCodeKey(test, mutationPoint, mutantCode));
+    if (!mutantCode.empty() && known != resultsByFunctionCode.end()) {
+      duplicateCodeMutants++;
+      return known->second;
+    }
+  }
+
+  /// Workers get the budget along with the job, without instrumenting
+  /// the program themselves
+  if (iterationBudget != 0) {
+    mutant = compileMutantWithLoopBudget(mutationPoint);
+    LoopBudget::setBudget(iterationBudget);
+  } else if (mutant == nullptr) {
+    mutant = compileMutant(mutationPoint);
+  }
+  objectFiles.push_back(mutant);
+
+  Trace &trace = Trace::shared();
+  const long long start = trace.isEnabled() ? trace.now() : 0;
+
+  result = Sandbox->run([&](ExecutionResult *SharedResult) {
+    ExecutionResult R = Runner.runTest(test, objectFiles);
+
+    assert(R.Status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+
+    *SharedResult = R;
+  }, timeout);
+  objectFiles.pop_back();
+
+  /// Anything but the test itself, e.g. forking, linking and collecting
+  /// the output, is the overhead of the sandbox
+  if (trace.isEnabled()) {
+    const long long elapsed = trace.now() - start;
+    const long long overhead = std::max(0LL, elapsed - result.RunningTime);
+    trace.addSpan("run mutant", "run", start, elapsed,
+                  test->getTestName() + " " + mutationPoint->getUniqueIdentifier());
+    trace.addSpan("sandbox overhead", "run", start + elapsed - overhead, overhead);
+  }
+
+  assert(result.Status != ExecutionStatus::Invalid && "Expect to see valid TestResult");
+
+  if (!mutantCode.empty()) {
+    resultsByFunctionCode[functionCodeKey(test, mutationPoint, mutantCode)] = result;
+  }
+
+  return result;
+}
+
+/// In mutant-centric mode a mutant runs against all its tests on one shard,
+/// otherwise each pair of a test and a mutant is a job on its own
+std::vector<MutationPoint *>
+Driver::OwnMutationPoints(const std::vector<MutationPoint *> &mutationPoints,
+                          Test *test,
+                          uint64_t cost) {
+  std::vector<MutationPoint *> own;
+  for (auto mutationPoint : mutationPoints) {
+    std::string job = mutationPoint->getUniqueIdentifier();
+    if (!Cfg.isMutantCentric()) {
+      job = test->getTestName() + "\n" + job;
+    }
+
+    if (shardPlanner.isOwnJob(job, cost)) {
+      own.push_back(mutationPoint);
+    }
+  }
+  return own;
+}
+
+const ExecutionResult *Driver::baselineResult(Test *test,
+                                              const std::string &testeesHash,
+                                              MutationPoint *mutationPoint) {
+  if (baseline.size() == 0) {
+    return nullptr;
+  }
+
+  const ExecutionResult *result =
+    baseline.findResult(test->getTestName(),
+                        testeesHash,
+                        functionHasher.stableIdentifier(mutationPoint));
+  if (result) {
+    carriedResults++;
+  }
+  return result;
+}
+
+ObjectFile *Driver::compileMutant(MutationPoint *mutationPoint) {
+  ObjectFile *mutant = toolchain.cache().getObject(*mutationPoint);
+  if (mutant == nullptr) {
+    TraceScope scope("compile mutant", "compile");
+    auto owningObject = mutationPoint->applyMutation(toolchain.compiler());
+    mutant = owningObject.getBinary();
+    toolchain.cache().putObject(std::move(owningObject), *mutationPoint);
+  }
+  return mutant;
+}
+
+/// The original object holds all the functions of the module,
+/// hence the name is part of the key
+const std::string &Driver::functionCodeHash(ObjectFile *object,
+                                            MutationPoint *mutationPoint) {
+  const std::string functionName = mutatedFunctionName(mutationPoint);
+  auto key = std::make_pair(object, functionName);
+
+  auto known = functionCodeHashes.find(key);
+  if (known != functionCodeHashes.end()) {
+    return known->second;
+  }
+
+  std::string hash = hashFunctionCode(*object, functionName);
+  return functionCodeHashes.insert(std::make_pair(key, hash)).first->second;
+}
+
+
+ObjectFile *Driver::compileMutantWithLoopBudget(MutationPoint *mutationPoint) {
+  /// The guards are part of the object, which must not be confused
+  /// with the plain mutant
+  const std::string identifier = mutationPoint->getUniqueIdentifier() + "_loop_budget";
+
+  ObjectFile *mutant = toolchain.cache().getObject(identifier);
+  if (mutant != nullptr) {
+    return mutant;
+  }
+
+  TraceScope scope("compile mutant", "compile");
+  auto mutatedModule = mutationPoint->cloneModuleAndApplyMutation();
+  int functionIndex = mutationPoint->getAddress().getFnIndex();
+  Function &mutatedFunction = *(std::next(mutatedModule->begin(), functionIndex));
+  LoopBudget::instrumentBudget(mutatedFunction);
+
+  auto owningObject = toolchain.compiler().compileModule(mutatedModule.get());
+  mutant = owningObject.getBinary();
+  toolchain.cache().putObject(std::move(owningObject), identifier);
+
+  return mutant;
+}
+
+void Driver::addKillerCandidate(MutationPoint *mutationPoint,
+                                TestResult *testResult,
+                                Test *test,
+                                Testee *testee,
+                                long long timeout,
+                                uint64_t iterationBudget) {
+  auto inserted = killerCandidateIndices.insert(
+    std::make_pair(mutationPoint->getUniqueIdentifier(), killerCandidates.size()));
+
+  if (inserted.second) {
+    killerCandidates.emplace_back(mutationPoint, std::vector<KillerCandidate>());
+  }
+
+  auto &candidates = killerCandidates[inserted.first->second].second;
+  candidates.push_back({ testResult, test, testee, timeout, iterationBudget });
+}
+
+/// Each mutant is run against the tests reaching it, closest tests first.
+/// Among the tests at the same distance the ones that killed more mutants
+/// so far go first. The first test that does not pass kills the mutant,
+/// the remaining tests are not run at all.
+void Driver::runMutantsByKillLikelihood() {
+  /// Number of mutants killed and number of mutants run, per test
+  std::map<Test *, std::pair<int, int>> killStatistics;
+
+  auto killRate = [&](Test *test) {
+    auto &statistics = killStatistics[test];
+    /// Tests that have not run yet are neither good nor bad killers
+    return (statistics.first + 1.0) / (statistics.second + 2.0);
+  };
+
+  for (auto &entry : killerCandidates) {
+    MutationPoint *mutationPoint = entry.first;
+    auto &candidates = entry.second;
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](const KillerCandidate &a, const KillerCandidate &b) {
+                       if (a.testee->getDistance() != b.testee->getDistance()) {
+                         return a.testee->getDistance() < b.testee->getDistance();
+                       }
+                       return killRate(a.test) > killRate(b.test);
+                     });
+
+    Module *mutatedModule = candidates.front().testee->getTesteeFunction()->getParent();
+    auto ObjectFiles = AllButOne(mutatedModule);
+
+    for (auto &candidate : candidates) {
+      ExecutionResult result = runMutant(mutationPoint, candidate.test,
+                                         ObjectFiles, candidate.timeout,
+                                         candidate.iterationBudget);
+
+      auto MutResult = make_unique<MutationResult>(result, mutationPoint,
+                                                   candidate.testee);
+      candidate.testResult->addMutantResult(std::move(MutResult));
+
+      if (result.Status == ExecutionStatus::DryRun) {
+        continue;
+      }
+
+      /// No test can kill it
+      if (result.Status == ExecutionStatus::Equivalent) {
+        break;
+      }
+
+      auto &statistics = killStatistics[candidate.test];
+      statistics.second++;
+
+      if (result.Status != ExecutionStatus::Passed) {
+        statistics.first++;
+        break;
+      }
+    }
+  }
+
+  killerCandidates.clear();
+  killerCandidateIndices.clear();
+}
+
+/// The coordinator hands the jobs out one at a time, so faster workers take
+/// more of them. Jobs of a worker that goes away are handed out again, and
+/// the ones no worker could finish are run by the coordinator itself.
+void Driver::runJobsOnWorkers() {
+  std::string socketPath = Cfg.getWorkerSocket();
+  if (socketPath.empty()) {
+    socketPath = "/tmp/mutang_" + std::to_string(getpid()) + ".sock";
+  }
+
+  std::vector<ExecutionResult> results(remoteJobs.size());
+  std::vector<bool> finished(remoteJobs.size(), false);
+  size_t finishedCount = 0;
+
+  std::deque<uint64_t> queue;
+  for (uint64_t id = 0; id < remoteJobs.size(); id++) {
+    queue.push_back(id);
+  }
+
+  int listener = WorkerChannel::listenOn(socketPath, Cfg.getWorkers());
+  std::vector<pid_t> workerPIDs;
+  if (listener != -1) {
+    workerPIDs = startWorkers(socketPath, listener);
+  }
+
+  /// Connected workers along with the job each of them is running, if any
+  std::vector<std::pair<std::unique_ptr<WorkerChannel>, int64_t>> channels;
+
+  auto reapWorkers = [&]() {
+    workerPIDs.erase(std::remove_if(workerPIDs.begin(), workerPIDs.end(),
+                                    [](pid_t pid) {
+                                      return waitpid(pid, nullptr, WNOHANG) != 0;
+                                    }),
+                     workerPIDs.end());
+  };
+
+  while (listener != -1 && finishedCount < remoteJobs.size()) {
+    reapWorkers();
+    if (channels.empty() && workerPIDs.empty()) {
+      break;
+    }
+
+    std::vector<pollfd> descriptors;
+    descriptors.push_back({ listener, POLLIN, 0 });
+    for (auto &channel : channels) {
+      descriptors.push_back({ channel.first->getFileDescriptor(), POLLIN, 0 });
+    }
+
+    const int ready = poll(descriptors.data(), descriptors.size(), 1000);
+    if (ready <= 0) {
+      continue;
+    }
+
+    /// Channels are removed from the back so that the indices of the
+    /// remaining ones still match the descriptors
+    for (size_t index = descriptors.size() - 1; index > 0; index--) {
+      if (descriptors[index].revents == 0) {
+        continue;
+      }
+
+      auto &channel = channels[index - 1];
+      std::vector<std::string> message;
+      const bool connected = channel.first->receive(message);
+
+      uint64_t id = 0;
+      ExecutionResult result;
+      if (connected && WorkerChannel::decodeResult(message, id, result)) {
+        /// A worker that could not run the job leaves it to the coordinator
+        if (id < remoteJobs.size() && !finished[id] &&
+            result.Status != ExecutionStatus::Invalid) {
+          results[id] = result;
+          finished[id] = true;
+          finishedCount++;
+        }
+        channel.second = -1;
+      } else if (!connected || message.empty() ||
+                 message.front() != WorkerMessage::Ready) {
+        if (channel.second != -1) {
+          queue.push_front(channel.second);
+        }
+        channels.erase(channels.begin() + (index - 1));
+        continue;
+      }
+
+      if (queue.empty()) {
+        channel.first->send({ WorkerMessage::Done });
+        channels.erase(channels.begin() + (index - 1));
+        continue;
+      }
+
+      id = queue.front();
+      queue.pop_front();
+
+      auto &job = remoteJobs[id];
+      WorkerJob workerJob = { id,
+                              job.candidate.test->getTestName(),
+                              job.mutationPoint->getUniqueIdentifier(),
+                              job.candidate.timeout,
+                              job.candidate.iterationBudget };
+      if (!channel.first->sendJob(workerJob)) {
+        queue.push_front(id);
+        channels.erase(channels.begin() + (index - 1));
+        continue;
+      }
+      channel.second = id;
+    }
+
+    if (descriptors.front().revents & POLLIN) {
+      const int fd = accept(listener, nullptr, nullptr);
+      if (fd != -1) {
+        channels.emplace_back(make_unique<WorkerChannel>(fd), -1);
+      }
+    }
+  }
+
+  for (auto &channel : channels) {
+    channel.first->send({ WorkerMessage::Done });
+  }
+  channels.clear();
+
+  if (listener != -1) {
+    close(listener);
+    unlink(socketPath.c_str());
+  }
+
+  for (auto pid : workerPIDs) {
+    waitpid(pid, nullptr, 0);
+  }
+
+  if (finishedCount < remoteJobs.size()) {
+    Logger::warn() << "Workers did not finish " << remoteJobs.size() - finishedCount
+                   << " of " << remoteJobs.size() << " jobs, running them here\n";
+  }
+
+  for (uint64_t id = 0; id < remoteJobs.size(); id++) {
+    auto &job = remoteJobs[id];
+    Testee *testee = job.candidate.testee;
+
+    if (!finished[id]) {
+      auto ObjectFiles = AllButOne(testee->getTesteeFunction()->getParent());
+      results[id] = runMutant(job.mutationPoint, job.candidate.test, ObjectFiles,
+                              job.candidate.timeout, job.candidate.iterationBudget);
+    }
+
+    job.candidate.testResult->addMutantResult(
+      make_unique<MutationResult>(results[id], job.mutationPoint, testee));
+  }
+
+  remoteJobs.clear();
+}
+
+std::vector<pid_t> Driver::startWorkers(const std::string &socketPath,
+                                        int listener) {
+  std::string command = Cfg.getWorkerCommand();
+  const std::string placeholder = "{socket}";
+  for (size_t position = command.find(placeholder);
+       position != std::string::npos;
+       position = command.find(placeholder, position + socketPath.size())) {
+    command.replace(position, placeholder.size(), socketPath);
+  }
+
+  std::vector<pid_t> workerPIDs;
+  for (int i = 0; i < Cfg.getWorkers(); i++) {
+    const pid_t pid = fork();
+    if (pid == -1) {
+      Logger::error() << "Failed to start worker " << i << "\n";
+      break;
+    }
+
+    if (pid == 0) {
+      close(listener);
+
+      /// A forked worker already has the program loaded, linked and
+      /// initialized, just as the coordinator
+      if (command.empty()) {
+        serveJobs(socketPath);
+        _exit(0);
+      }
+
+      execl("/bin/sh", "sh", "-c", command.c_str(), (char *)nullptr);
+      _exit(127);
+    }
+
+    workerPIDs.push_back(pid);
+  }
+
+  return workerPIDs;
+}
+
+void Driver::RunWorker(const std::string &socketPath) {
+  LoadProgram();
+  indexWorkerTests();
+
+  if (Cfg.getZygote() && Cfg.getFork() && !workerTests.empty()) {
+    Runner.initializeProgram(workerTests.front().get());
+  }
+
+  serveJobs(socketPath);
+}
+
+void Driver::serveJobs(const std::string &socketPath) {
+  const int fd = WorkerChannel::connectTo(socketPath);
+  if (fd == -1) {
+    return;
+  }
+  WorkerChannel channel(fd);
+
+  indexWorkerTests();
+
+  if (!channel.send({ WorkerMessage::Ready })) {
+    return;
+  }
+
+  std::vector<std::string> message;
+  WorkerJob job;
+  while (channel.receive(message) && WorkerChannel::decodeJob(message, job)) {
+    ExecutionResult result = runWorkerJob(job);
+    if (!channel.sendResult(job.id, result)) {
+      return;
+    }
+  }
+}
+
+/// Tests are found in the same order by every process, so the first one
+/// is the same as the coordinator used for the zygote initialization
+void Driver::indexWorkerTests() {
+  if (!workerTests.empty()) {
+    return;
+  }
+
+  for (auto &test : Finder.findTests(Ctx)) {
+    testsByName[test->getTestName()] = test.get();
+    workerTests.push_back(std::move(test));
+  }
+}
+
+ExecutionResult Driver::runWorkerJob(const WorkerJob &job) {
+  ExecutionResult result;
+  result.Status = ExecutionStatus::Invalid;
+  result.RunningTime = 0;
+
+  auto test = testsByName.find(job.testName);
+  if (test == testsByName.end()) {
+    Logger::error() << "Worker does not know test " << job.testName << "\n";
+    return result;
+  }
+
+  /// Mutation points are found the first time a job of their test comes
+  if (resolvedTests.insert(test->second).second) {
+    auto testees = Finder.findTestees(test->second, Ctx, Cfg.getMaxDistance());
+    for (auto testee_it = std::next(testees.begin()), ee = testees.end();
+         testee_it != ee;
+         ++testee_it) {
+      Function *function = (*testee_it)->getTesteeFunction();
+      for (auto mutationPoint : Finder.findMutationPoints(Ctx, *function)) {
+        workerMutationPoints[mutationPoint->getUniqueIdentifier()] =
+          std::make_pair(mutationPoint, function->getParent());
+      }
+    }
+  }
+
+  auto mutationPoint = workerMutationPoints.find(job.mutationPoint);
+  if (mutationPoint == workerMutationPoints.end()) {
+    Logger::error() << "Worker does not know mutation point "
+                    << job.mutationPoint << "\n";
+    return result;
+  }
+
+  auto ObjectFiles = AllButOne(mutationPoint->second.second);
+  return runMutant(mutationPoint->second.first, test->second, ObjectFiles,
+                   job.timeout, job.iterationBudget);
+}
+
 std::vector<llvm::object::ObjectFile *> Driver::AllButOne(llvm::Module *One) {
   std::vector<llvm::object::ObjectFile *> Objects;
 
@@ -208,8 +995,8 @@ void Driver::debug_PrintTesteeNames() {
 
   for (auto &Test : Finder.findTests(Ctx)) {
     Logger::info() << Test->getTestName() << "\n";
-    for (auto &testee : Finder.findTestees(Test.get(), Ctx, Cfg.getMaxDistance())) {
-      Logger::info().indent(2) << testee.get()->getTesteeFunction()->getName() << "\n";
+    for (auto testee : Finder.findTestees(Test.get(), Ctx, Cfg.getMaxDistance())) {
+      Logger::info().indent(2) << testee->getTesteeFunction()->getName() << "\n";
     }
   }
 }
@@ -223,10 +1010,14 @@ void Driver::debug_PrintMutationPoints() {
 
   for (auto &Test : Finder.findTests(Ctx)) {
     Logger::info() << Test->getTestName() << "\n";
-    for (auto &testee: Finder.findTestees(Test.get(), Ctx, Cfg.getMaxDistance())) {
-      auto MPoints = Finder.findMutationPoints(Ctx, *(testee.get()->getTesteeFunction()));
+    for (auto testee: Finder.findTestees(Test.get(), Ctx, Cfg.getMaxDistance())) {
+      if (functionFilter.shouldSkipFunction(*testee->getTesteeFunction())) {
+        continue;
+      }
+
+      auto MPoints = Finder.findMutationPoints(Ctx, *(testee->getTesteeFunction()));
       if (MPoints.size()) {
-        Logger::info().indent(2) << testee.get()->getTesteeFunction()->getName() << "\n";
+        Logger::info().indent(2) << testee->getTesteeFunction()->getName() << "\n";
       }
       for (auto &MPoint : MPoints) {
         Logger::info().indent(4);
@@ -0,0 +1,94 @@
+#include "EquivalentMutantFilter.h"
+
+#include "MutangModule.h"
+#include "MutationPoint.h"
+
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <iterator>
+
+using namespace llvm;
+using namespace Mutang;
+
+/// Brings the function to a canonical form and prints it.
+/// Debug info is stripped as mutation operators do not carry it over to
+/// the instructions they create, names are kept as operators preserve them
+static std::string simplifyFunction(Module &module, int functionIndex) {
+  StripDebugInfo(module);
+
+  Function &function = *(std::next(module.begin(), functionIndex));
+
+  legacy::FunctionPassManager passes(&module);
+  passes.add(createInstructionSimplifierPass());
+  passes.add(createDeadCodeEliminationPass());
+
+  passes.doInitialization();
+  passes.run(function);
+  passes.doFinalization();
+
+  std::string text;
+  raw_string_ostream stream(text);
+  function.print(stream);
+  return stream.str();
+}
+
+const std::string &
+EquivalentMutantFilter::simplifiedOriginal(MutationPoint *mutationPoint) {
+  Module *original = mutationPoint->getOriginalModule()->getModule();
+  int functionIndex = mutationPoint->getAddress().getFnIndex();
+
+  std::string key = mutationPoint->getOriginalModule()->getUniqueIdentifier() +
+                    "_" + std::to_string(functionIndex);
+
+  auto it = originalFunctions.find(key);
+  if (it != originalFunctions.end()) {
+    return it->second;
+  }
+
+  auto copy = CloneModule(original);
+  std::string text = simplifyFunction(*copy, functionIndex);
+  return originalFunctions.insert(std::make_pair(key, std::move(text))).first->second;
+}
+
+bool EquivalentMutantFilter::shouldSkip(MutationPoint *mutationPoint) {
+  auto verdict = verdicts.find(mutationPoint->getUniqueIdentifier());
+  if (verdict != verdicts.end()) {
+    return verdict->second;
+  }
+
+  int functionIndex = mutationPoint->getAddress().getFnIndex();
+  auto mutatedModule = mutationPoint->cloneModuleAndApplyMutation();
+  std::string mutated = simplifyFunction(*mutatedModule, functionIndex);
+
+  bool skip = false;
+  if (mutated == simplifiedOriginal(mutationPoint)) {
+    equivalentCount++;
+    skip = true;
+  } else {
+    std::string key = mutationPoint->getOriginalModule()->getUniqueIdentifier() +
+                      "\n" + mutated;
+    if (!mutatedFunctions.insert(key).second) {
+      redundantCount++;
+      skip = true;
+    }
+  }
+
+  verdicts[mutationPoint->getUniqueIdentifier()] = skip;
+  return skip;
+}
+
+std::vector<MutationPoint *>
+EquivalentMutantFilter::filter(const std::vector<MutationPoint *> &mutationPoints) {
+  std::vector<MutationPoint *> remaining;
+  for (auto mutationPoint : mutationPoints) {
+    if (!shouldSkip(mutationPoint)) {
+      remaining.push_back(mutationPoint);
+    }
+  }
+  return remaining;
+}
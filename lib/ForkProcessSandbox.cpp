@@ -1,12 +1,19 @@
 #include "ForkProcessSandbox.h"
 
 #include "Logger.h"
+#include "LoopBudget.h"
 #include "TestResult.h"
 
+#include <cerrno>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
 #include <signal.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
 
@@ -31,6 +38,88 @@ pid_t mutangFork(const char *processName) {
   return pid;
 }
 
+static long long timevalMicroseconds(const timeval &time) {
+  return time.tv_sec * 1000000LL + time.tv_usec;
+}
+
+static Mutang::ResourceUsage resourceUsage(const rusage &usage) {
+  Mutang::ResourceUsage result;
+  result.UserTime = timevalMicroseconds(usage.ru_utime);
+  result.SystemTime = timevalMicroseconds(usage.ru_stime);
+  result.MaxRSS = usage.ru_maxrss;
+  result.MajorFaults = usage.ru_majflt;
+  result.MinorFaults = usage.ru_minflt;
+  result.ContextSwitches = usage.ru_nvcsw + usage.ru_nivcsw;
+  return result;
+}
+
+/// Size of the address space of the current process, zero if unknown
+static unsigned long long addressSpaceSize() {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+
+  unsigned long long pages = 0;
+  if (fscanf(statm, "%llu", &pages) != 1) {
+    pages = 0;
+  }
+  fclose(statm);
+
+  return pages * sysconf(_SC_PAGESIZE);
+}
+
+static void exitOnFailedAllocation() {
+  _exit(Mutang::ResourceLimitExceededExitCode);
+}
+
+/// malloc and mmap set errno to ENOMEM when they hit the limit, and code
+/// not checking for it faults on the null pointer right away. Other faults
+/// are crashes, as they would have been without the handler.
+static void exitOnFaultAfterFailedAllocation(int signal) {
+  if (errno == ENOMEM) {
+    _exit(Mutang::ResourceLimitExceededExitCode);
+  }
+  raise(signal);
+}
+
+/// The worker inherits the whole address space of the driver, with the
+/// program and LLVM in it, so the memory limit is counted from its size.
+/// Allocations of the JIT-ed code go through the host's operator new, which
+/// ends the process once it cannot allocate any more, or through malloc,
+/// which returns null
+static void applyResourceLimits(long long memoryLimit, long long cpuLimit) {
+  if (memoryLimit > 0) {
+    const unsigned long long inherited = addressSpaceSize();
+    if (inherited != 0) {
+      rlimit limit;
+      limit.rlim_cur = inherited + memoryLimit * 1024 * 1024;
+      limit.rlim_max = limit.rlim_cur;
+      setrlimit(RLIMIT_AS, &limit);
+      std::set_new_handler(exitOnFailedAllocation);
+
+      struct sigaction action;
+      memset(&action, 0, sizeof(action));
+      action.sa_handler = exitOnFaultAfterFailedAllocation;
+      action.sa_flags = SA_RESETHAND;
+      sigemptyset(&action.sa_mask);
+      sigaction(SIGSEGV, &action, nullptr);
+      sigaction(SIGBUS, &action, nullptr);
+
+      /// Whatever the driver left there does not count
+      errno = 0;
+    }
+  }
+
+  /// The soft limit sends SIGXCPU, the hard one SIGKILL if it is ignored
+  if (cpuLimit > 0) {
+    rlimit limit;
+    limit.rlim_cur = cpuLimit;
+    limit.rlim_max = cpuLimit + 1;
+    setrlimit(RLIMIT_CPU, &limit);
+  }
+}
+
 Mutang::ExecutionResult
 Mutang::ForkProcessSandbox::run(std::function<void (ExecutionResult *)> function,
                                 long long timeoutMilliseconds) {
@@ -82,33 +171,61 @@ Mutang::ForkProcessSandbox::run(std::function<void (ExecutionResult *)> function
 
       //      execl("/bin/pwd", "pwd", (char*)0);
 
+      applyResourceLimits(memoryLimit, cpuLimit);
+
       function(sharedResult);
 
       exit(0);
     }
 
     int status = 0;
-    const pid_t exitedPID = waitpid(WAIT_ANY, &status, 0);
+    rusage usage;
+    const pid_t exitedPID = wait4(WAIT_ANY, &status, 0, &usage);
     if (exitedPID == timerPID) {
       /// Timer Process finished first, meaning that the worker timed out
       kill(workerPID, SIGKILL);
       auto elapsed = high_resolution_clock::now() - start;
 
+      /// The usage of the killed worker is known once it is waited for
+      wait4(workerPID, &status, 0, &usage);
+
       ExecutionResult result;
       result.Status = Timedout;
-      result.RunningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
+      result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
+      result.Usage = resourceUsage(usage);
       *sharedResult = result;
     } else if (exitedPID == workerPID) {
       kill(timerPID, SIGKILL);
       /// Worker Process finished first
-      /// Need to check whether it has signaled (crashed) or finished normally
-      if (WIFSIGNALED(status)) {
+      /// Need to check whether it has signaled (crashed) or finished normally.
+      /// The hard CPU limit sends SIGKILL, which is only told apart from
+      /// any other SIGKILL by the CPU time used
+      const long long cpuTime = timevalMicroseconds(usage.ru_utime) +
+                                timevalMicroseconds(usage.ru_stime);
+      const bool reachedCPULimit = cpuLimit > 0 && cpuTime >= cpuLimit * 1000000LL;
+      if ((WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU) ||
+          (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL && reachedCPULimit) ||
+          (WIFEXITED(status) && WEXITSTATUS(status) == ResourceLimitExceededExitCode)) {
         auto elapsed = high_resolution_clock::now() - start;
         ExecutionResult result;
-        result.RunningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
+        result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
+        result.Status = ResourceLimitExceeded;
+        *sharedResult = result;
+      } else if (WIFSIGNALED(status)) {
+        auto elapsed = high_resolution_clock::now() - start;
+        ExecutionResult result;
+        result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
         result.Status = Crashed;
         *sharedResult = result;
+      } else if (WIFEXITED(status) &&
+                 WEXITSTATUS(status) == LoopBudgetExceededExitCode) {
+        auto elapsed = high_resolution_clock::now() - start;
+        ExecutionResult result;
+        result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
+        result.Status = LoopBudgetExceeded;
+        *sharedResult = result;
       }
+      sharedResult->Usage = resourceUsage(usage);
     } else {
       llvm_unreachable("Should not reach!");
     }
@@ -187,9 +304,23 @@ Mutang::ExecutionResult Mutang::NullProcessSandbox::run(std::function<void (Exec
 
   ExecutionResult *SharedResult = new (SharedMemory) ExecutionResult();
 
+  /// The test runs in this very process: CPU time, faults and context
+  /// switches are the difference, the peak memory is the one of the process
+  rusage before;
+  getrusage(RUSAGE_SELF, &before);
+
   function(SharedResult);
 
+  rusage after;
+  getrusage(RUSAGE_SELF, &after);
+
   ExecutionResult Result = *SharedResult;
+  Result.Usage = resourceUsage(after);
+  Result.Usage.UserTime -= timevalMicroseconds(before.ru_utime);
+  Result.Usage.SystemTime -= timevalMicroseconds(before.ru_stime);
+  Result.Usage.MajorFaults -= before.ru_majflt;
+  Result.Usage.MinorFaults -= before.ru_minflt;
+  Result.Usage.ContextSwitches -= before.ru_nvcsw + before.ru_nivcsw;
 
   free(SharedMemory);
 
@@ -0,0 +1,118 @@
+#include "FunctionFilter.h"
+
+#include "Config.h"
+#include "ConfigParser.h"
+
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/Function.h"
+
+#include <cxxabi.h>
+#include <cstdlib>
+
+using namespace llvm;
+using namespace Mutang;
+
+static std::vector<GlobPattern> compilePatterns(const std::vector<std::string> &patterns) {
+  std::vector<GlobPattern> compiled;
+
+  for (auto &pattern : patterns) {
+    Expected<GlobPattern> glob = GlobPattern::create(pattern);
+    if (!glob) {
+      configurationError("invalid pattern '" + pattern + "': " +
+                         toString(glob.takeError()));
+    }
+    compiled.push_back(std::move(glob.get()));
+  }
+
+  return compiled;
+}
+
+static bool matchesAny(const std::vector<GlobPattern> &patterns,
+                       const std::vector<std::string> &values) {
+  for (auto &pattern : patterns) {
+    for (auto &value : values) {
+      if (pattern.match(value)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static std::string demangle(StringRef name) {
+  int status = 0;
+  char *demangled = abi::__cxa_demangle(name.str().c_str(), nullptr, nullptr, &status);
+  if (status != 0) {
+    return name.str();
+  }
+
+  std::string result(demangled);
+  free(demangled);
+  return result;
+}
+
+FunctionFilter::FunctionFilter(const std::vector<std::string> &includeLocations,
+                               const std::vector<std::string> &excludeLocations,
+                               const std::vector<std::string> &includeFunctions,
+                               const std::vector<std::string> &excludeFunctions)
+  : includedLocations(compilePatterns(includeLocations)),
+    excludedLocations(compilePatterns(excludeLocations)),
+    includedNames(compilePatterns(includeFunctions)),
+    excludedNames(compilePatterns(excludeFunctions))
+{
+}
+
+FunctionFilter::FunctionFilter(const Config &config)
+  : FunctionFilter(config.getIncludeLocations(),
+                   config.getExcludeLocations(),
+                   config.getIncludeFunctions(),
+                   config.getExcludeFunctions())
+{
+}
+
+bool FunctionFilter::shouldSkipFunction(Function &function) {
+  auto verdict = verdicts.find(&function);
+  if (verdict != verdicts.end()) {
+    return verdict->second;
+  }
+
+  bool skip = computeShouldSkip(function);
+  verdicts[&function] = skip;
+  return skip;
+}
+
+bool FunctionFilter::computeShouldSkip(Function &function) const {
+  if (!includedNames.empty() || !excludedNames.empty()) {
+    std::vector<std::string> names({ function.getName().str(),
+                                     demangle(function.getName()) });
+
+    if (!includedNames.empty() && !matchesAny(includedNames, names)) {
+      return true;
+    }
+    if (matchesAny(excludedNames, names)) {
+      return true;
+    }
+  }
+
+  if (!includedLocations.empty() || !excludedLocations.empty()) {
+    /// Functions without debug info have no location,
+    /// they can only be excluded by name
+    std::vector<std::string> locations;
+    if (DISubprogram *subprogram = function.getSubprogram()) {
+      std::string path = subprogram->getFilename().str();
+      if (!path.empty() && path[0] != '/' && !subprogram->getDirectory().empty()) {
+        path = subprogram->getDirectory().str() + "/" + path;
+      }
+      locations.push_back(path);
+    }
+
+    if (!includedLocations.empty() && !matchesAny(includedLocations, locations)) {
+      return true;
+    }
+    if (matchesAny(excludedLocations, locations)) {
+      return true;
+    }
+  }
+
+  return false;
+}
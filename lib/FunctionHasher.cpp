@@ -0,0 +1,230 @@
+#include "FunctionHasher.h"
+
+#include "Context.h"
+#include "MutationPoint.h"
+
+#include "MutationOperators/MutationOperator.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+using namespace llvm;
+using namespace Mutang;
+
+static std::string MD5HashFromString(StringRef string) {
+  MD5 hasher;
+  hasher.update(string);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str();
+}
+
+/// Drops references to metadata (`!dbg !12`, `!tbaa !7`, etc.) and to
+/// attribute groups (`#0`), both are numbered per module. Quoted strings,
+/// e.g. `c"#1"`, are kept as they are: the printer escapes their quotes.
+static std::string withoutMetadata(StringRef ir) {
+  std::string result;
+  result.reserve(ir.size());
+
+  for (size_t i = 0; i < ir.size(); i++) {
+    if (ir[i] == '"') {
+      const size_t end = ir.find('"', i + 1);
+      const size_t last = end == StringRef::npos ? ir.size() - 1 : end;
+      result.append(ir.data() + i, last - i + 1);
+      i = last;
+      continue;
+    }
+    if (ir[i] == '#' && i + 1 < ir.size() && isdigit(ir[i + 1])) {
+      while (i + 1 < ir.size() && isdigit(ir[i + 1])) {
+        i++;
+      }
+      continue;
+    }
+    if (ir[i] == '!' && i + 1 < ir.size() &&
+        (isalnum(ir[i + 1]) || ir[i + 1] == '_')) {
+      while (i + 1 < ir.size() &&
+             (isalnum(ir[i + 1]) || ir[i + 1] == '_' || ir[i + 1] == '.')) {
+        i++;
+      }
+      continue;
+    }
+    result.push_back(ir[i]);
+  }
+
+  return result;
+}
+
+/// Globals the function refers to, directly or through constant
+/// expressions and the initializers of other globals
+static std::vector<GlobalVariable *> referencedGlobals(Function &function) {
+  std::vector<GlobalVariable *> globals;
+  SmallPtrSet<Value *, 16> visited;
+  std::vector<Value *> worklist;
+
+  for (auto &instruction : instructions(function)) {
+    for (auto &operand : instruction.operands()) {
+      worklist.push_back(operand.get());
+    }
+  }
+
+  while (!worklist.empty()) {
+    Value *value = worklist.back();
+    worklist.pop_back();
+    if (!visited.insert(value).second) {
+      continue;
+    }
+
+    if (auto global = dyn_cast<GlobalVariable>(value)) {
+      globals.push_back(global);
+      if (global->hasInitializer()) {
+        worklist.push_back(global->getInitializer());
+      }
+    } else if (isa<Constant>(value) && !isa<GlobalValue>(value)) {
+      for (auto &operand : cast<Constant>(value)->operands()) {
+        worklist.push_back(operand.get());
+      }
+    }
+  }
+
+  return globals;
+}
+
+const std::string &FunctionHasher::hashFunction(Function &function) {
+  auto known = hashes.find(&function);
+  if (known != hashes.end()) {
+    return known->second;
+  }
+
+  std::string ir;
+  raw_string_ostream stream(ir);
+  function.print(stream);
+  for (auto global : referencedGlobals(function)) {
+    global->print(stream);
+    stream << "\n";
+  }
+  stream.flush();
+
+  std::string hash = MD5HashFromString(withoutMetadata(ir));
+  return hashes.insert(std::make_pair(&function, hash)).first->second;
+}
+
+std::string FunctionHasher::stableIdentifier(MutationPoint *mutationPoint) {
+  Instruction *instruction = cast<Instruction>(mutationPoint->getOriginalValue());
+  MutationPointAddress address = mutationPoint->getAddress();
+
+  return hashFunction(*instruction->getFunction()) + "_" +
+         std::to_string(address.getBBIndex()) + "_" +
+         std::to_string(address.getIIndex()) + "_" +
+         mutationPoint->getOperator()->uniqueID();
+}
+
+/// Globals defined in another module are only declared where they are used
+static GlobalVariable *definitionOf(GlobalVariable *global, Context &context) {
+  if (!global->isDeclaration()) {
+    return global;
+  }
+  for (auto &module : context.getModules()) {
+    GlobalVariable *definition = module->getModule()->getGlobalVariable(global->getName());
+    if (definition && !definition->isDeclaration()) {
+      return definition;
+    }
+  }
+  return global;
+}
+
+/// Functions the test may run: the test's own module and the static
+/// constructors, then every function referred to by those, whether called
+/// or only taken the address of (and so maybe called indirectly), directly
+/// or through constants and the initializers of globals, however far away
+static std::vector<Function *> reachableFunctions(Function &testFunction,
+                                                  Context &context) {
+  std::vector<Function *> functions;
+  SmallPtrSet<Value *, 64> visited;
+  std::vector<Value *> worklist;
+
+  for (auto &function : *testFunction.getParent()) {
+    worklist.push_back(&function);
+  }
+  for (auto constructor : context.getStaticConstructors()) {
+    worklist.push_back(constructor);
+  }
+
+  while (!worklist.empty()) {
+    Value *value = worklist.back();
+    worklist.pop_back();
+
+    if (auto function = dyn_cast<Function>(value)) {
+      if (function->isDeclaration()) {
+        Function *definition = context.lookupDefinedFunction(function->getName());
+        if (definition == nullptr) {
+          continue;
+        }
+        function = definition;
+      }
+      if (!visited.insert(function).second) {
+        continue;
+      }
+
+      functions.push_back(function);
+      for (auto &instruction : instructions(function)) {
+        for (auto &operand : instruction.operands()) {
+          worklist.push_back(operand.get());
+        }
+      }
+    } else if (auto global = dyn_cast<GlobalVariable>(value)) {
+      global = definitionOf(global, context);
+      if (visited.insert(global).second && global->hasInitializer()) {
+        worklist.push_back(global->getInitializer());
+      }
+    } else if (isa<Constant>(value) && !isa<GlobalValue>(value)) {
+      if (visited.insert(value).second) {
+        for (auto &operand : cast<Constant>(value)->operands()) {
+          worklist.push_back(operand.get());
+        }
+      }
+    }
+  }
+
+  return functions;
+}
+
+const std::string &FunctionHasher::hashReachableCode(Function &testFunction,
+                                                     Context &context) {
+  /// Tests of the same module start from the same functions
+  Module *testModule = testFunction.getParent();
+  auto known = reachableCodeHashes.find(testModule);
+  if (known != reachableCodeHashes.end()) {
+    return known->second;
+  }
+
+  /// Functions come in the order of discovery, which does not matter here
+  std::vector<std::string> functionHashes;
+  for (auto function : reachableFunctions(testFunction, context)) {
+    functionHashes.push_back(function->getName().str() + ":" + hashFunction(*function));
+  }
+  std::sort(functionHashes.begin(), functionHashes.end());
+  functionHashes.erase(std::unique(functionHashes.begin(), functionHashes.end()),
+                       functionHashes.end());
+
+  MD5 hasher;
+  for (auto &functionHash : functionHashes) {
+    hasher.update(functionHash);
+    hasher.update("\n");
+  }
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return reachableCodeHashes.insert(std::make_pair(testModule, result.str())).first->second;
+}
@@ -15,9 +15,6 @@
 
 #include "GoogleTest/GoogleTest_Test.h"
 
-#include "MutationOperators/AddMutationOperator.h"
-#include "MutationOperators/NegateConditionMutationOperator.h"
-#include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
 
 #include <queue>
 #include <set>
@@ -47,12 +44,10 @@ public:
   };
 };
 
-GoogleTestFinder::GoogleTestFinder() : TestFinder() {
-  /// FIXME: should come from outside
-  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
-  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
-  mutationOperators.emplace_back(make_unique<RemoveVoidFunctionMutationOperator>());
-}
+GoogleTestFinder::GoogleTestFinder(
+    std::vector<std::unique_ptr<MutationOperator>> mutationOperators)
+    : TestFinder(), mutationOperators(std::move(mutationOperators)),
+      scanner(this->mutationOperators) {}
 
 /// The algorithm is the following:
 ///
@@ -270,25 +265,26 @@ static bool shouldSkipDefinedFunction(llvm::Function *definedFunction) {
   return false;
 }
 
-std::vector<std::unique_ptr<Testee>>
+std::vector<Testee *>
 GoogleTestFinder::findTestees(Test *Test,
                               Context &Ctx,
                               int maxDistance) {
   GoogleTest_Test *googleTest = dyn_cast<GoogleTest_Test>(Test);
 
-  std::vector<std::unique_ptr<Testee>> testees;
+  TesteeArena &arena = Ctx.getTesteeArena();
+
+  std::vector<Testee *> testees;
   std::queue<Testee *> traversees;
   std::set<Function *> checkedFunctions;
 
   Module *testBodyModule = googleTest->GetTestBodyFunction()->getParent();
 
-  Testee *topLevelTestee = new Testee(googleTest->GetTestBodyFunction(),
-                                      nullptr,
-                                      nullptr,
-                                      0);
+  Testee *topLevelTestee = arena.create(googleTest->GetTestBodyFunction(),
+                                        nullptr,
+                                        nullptr,
+                                        0);
 
-  std::unique_ptr<Testee> uniqueTopLevelTestee(topLevelTestee);
-  testees.push_back(std::move(uniqueTopLevelTestee));
+  testees.push_back(topLevelTestee);
 
   traversees.push(topLevelTestee);
 
@@ -301,9 +297,7 @@ GoogleTestFinder::findTestees(Test *Test,
     /// as the test itself, then we are not looking for mutation points
     /// in this function assuming it to be a helper function, or the test itself
     if (traverseeFunction->getParent() != testBodyModule) {
-      std::unique_ptr<Testee> uniqueTestee(traversee);
-
-      testees.push_back(std::move(uniqueTestee));
+      testees.push_back(traversee);
     }
 
     /// The function reached the max allowed distance
@@ -388,10 +382,10 @@ GoogleTestFinder::findTestees(Test *Test,
           /// * Here is a good overview of what's going on:
           /// http://stackoverflow.com/a/6921467/829116
           ///
-          traversees.push(new Testee(definedFunction,
-                                     callInstruction,
-                                     traversee,
-                                     mutationDistance + 1));
+          traversees.push(arena.create(definedFunction,
+                                       callInstruction,
+                                       traversee,
+                                       mutationDistance + 1));
         }
       }
 
@@ -418,19 +412,11 @@ GoogleTestFinder::findMutationPoints(const Context &context,
 
   GoogleTestMutationOperatorFilter filter;
 
-  for (auto &mutationOperator : mutationOperators) {
-    for (auto point : mutationOperator->getMutationPoints(context, &testee, filter)) {
-      points.push_back(point);
-      MutationPoints.emplace_back(std::unique_ptr<MutationPoint>(point));
-    }
+  for (auto &point : scanner.scan(context, testee, filter)) {
+    points.push_back(point.get());
+    MutationPoints.emplace_back(std::move(point));
   }
 
   MutationPointsRegistry.insert(std::make_pair(&testee, points));
   return points;
 }
-
-std::vector<std::unique_ptr<MutationPoint>> GoogleTestFinder::findMutationPoints(
-                             std::vector<MutationOperator *> &MutationOperators,
-                             llvm::Function &F) {
-  return std::vector<std::unique_ptr<MutationPoint>>();
-}
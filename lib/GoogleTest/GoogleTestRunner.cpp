@@ -1,7 +1,9 @@
 #include "GoogleTest/GoogleTestRunner.h"
 
 #include "GoogleTest/GoogleTest_Test.h"
+#include "Toolchain/ProcessSymbolCache.h"
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
 #include "llvm/ExecutionEngine/GenericValue.h"
@@ -12,6 +14,7 @@
 
 #include <chrono>
 #include <execinfo.h>
+#include <vector>
 
 using namespace Mutang;
 using namespace llvm;
@@ -29,13 +32,11 @@ struct atexit_entry {
   void *dso_handle;
 };
 
-const static int dtors_count = 64;
-static int current_dtor = 0;
-static atexit_entry dtors[dtors_count];
+/// Destructors registered by the JIT-ed code, in order of registration
+static std::vector<atexit_entry> dtors;
+static DenseSet<std::pair<void *, void *>> registered_dtors;
 
 extern "C" int mutang__cxa_atexit(mutang_destructor_t destructor, void *arg, void *__dso_handle) {
-  assert(current_dtor < dtors_count);
-
 #if 0
   void* callstack[128];
   int i, frames = backtrace(callstack, 128);
@@ -46,30 +47,46 @@ extern "C" int mutang__cxa_atexit(mutang_destructor_t destructor, void *arg, voi
   free(strs);
 #endif
 
-  for (int i = 0; i < current_dtor; i++) {
-    if (arg == dtors[i].arg) {
-//      printf("dtor already registered: %d: %p\n", i, arg);
-      return 0;
-    }
+  if (!registered_dtors.insert(std::make_pair(__dso_handle, arg)).second) {
+    return 0;
   }
 
-//  printf("record dtor: %d: %p\n", current_dtor, arg);
-
-  dtors[current_dtor].destructor = destructor;
-  dtors[current_dtor].arg = arg;
-  dtors[current_dtor].dso_handle = __dso_handle;
-
-  current_dtor++;
+  dtors.push_back({ destructor, arg, __dso_handle });
 
   return 0;
 }
 
+static void runDestructor(const atexit_entry &entry) {
+  registered_dtors.erase(std::make_pair(entry.dso_handle, entry.arg));
+  entry.destructor(entry.arg);
+}
+
 void runDestructors() {
-//  printf("dtors: %d\n", current_dtor);
-  while (current_dtor > 0) {
-    current_dtor--;
-//    printf("cleaning dtor: %d: %p\n", current_dtor, dtors[current_dtor].arg);
-    dtors[current_dtor].destructor(dtors[current_dtor].arg);
+  while (!dtors.empty()) {
+    atexit_entry entry = dtors.back();
+    dtors.pop_back();
+    runDestructor(entry);
+  }
+}
+
+/// Runs destructors registered within the given dso handles only,
+/// the rest stay registered
+void runDestructors(const DenseSet<void *> &dsoHandles) {
+  std::vector<atexit_entry> scoped;
+  std::vector<atexit_entry> remaining;
+
+  for (auto &entry : dtors) {
+    if (dsoHandles.count(entry.dso_handle)) {
+      scoped.push_back(entry);
+    } else {
+      remaining.push_back(entry);
+    }
+  }
+
+  dtors.swap(remaining);
+
+  for (auto it = scoped.rbegin(); it != scoped.rend(); ++it) {
+    runDestructor(*it);
   }
 }
 
@@ -84,32 +101,57 @@ extern "C" int mutang_printf(const char *fmt, ...) {
   return 0;
 }
 
-extern "C" void *mutang__dso_handle = nullptr;
-
 class Mutang_GoogleTest_Resolver : public JITSymbolResolver {
+  orc::ObjectLinkingLayer<> &ObjectLayer;
+  void **DSOHandle;
 public:
+  Mutang_GoogleTest_Resolver(orc::ObjectLinkingLayer<> &layer, void **dsoHandle)
+    : ObjectLayer(layer), DSOHandle(dsoHandle) {}
 
   JITSymbol findSymbol(const std::string &Name) {
     if (Name == "___cxa_atexit") {
-      return findSymbol("mutang__cxa_atexit");
+      return ProcessSymbolCache::shared().findSymbol("mutang__cxa_atexit");
     }
 
     if (Name == "___dso_handle") {
-      return findSymbol("mutang__dso_handle");
+      return JITSymbol(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(DSOHandle)),
+                       JITSymbolFlags::Exported);
     }
 
-    if (auto SymAddr = RTDyldMemoryManager::getSymbolAddressInProcess(Name))
-      return JITSymbol(SymAddr, JITSymbolFlags::Exported);
-    return JITSymbol(nullptr);
+    return ProcessSymbolCache::shared().findSymbol(Name);
   }
 
+  /// Other modules of the program live in their own object sets, their
+  /// symbols are materialized on first use.
   JITSymbol findSymbolInLogicalDylib(const std::string &Name) {
-    return JITSymbol(nullptr);
+    return ObjectLayer.findSymbol(Name, false);
   }
 };
 
 GoogleTestRunner::GoogleTestRunner(llvm::TargetMachine &machine)
-  : TestRunner(machine) {}
+  : TestRunner(machine), ProgramInitialized(false) {}
+
+std::unique_ptr<JITSymbolResolver>
+GoogleTestRunner::createResolver(object::ObjectFile *objectFile) {
+  return make_unique<Mutang_GoogleTest_Resolver>(ObjectLayer,
+                                                 &DSOHandles[objectFile]);
+}
+
+void GoogleTestRunner::willUnloadObjectFiles(const std::vector<object::ObjectFile *> &objectFiles) {
+  DenseSet<void *> dsoHandles;
+  for (auto objectFile : objectFiles) {
+    auto dsoHandle = DSOHandles.find(objectFile);
+    if (dsoHandle != DSOHandles.end()) {
+      dsoHandles.insert(&dsoHandle->second);
+    }
+  }
+
+  runDestructors(dsoHandles);
+
+  for (auto objectFile : objectFiles) {
+    DSOHandles.erase(objectFile);
+  }
+}
 
 std::string GoogleTestRunner::MangleName(const llvm::StringRef &Name) {
   std::string MangledName;
@@ -140,19 +182,37 @@ void GoogleTestRunner::runStaticCtor(llvm::Function *Ctor) {
   ctor();
 }
 
-ExecutionResult GoogleTestRunner::runTest(Test *Test, ObjectFiles &ObjectFiles) {
+void GoogleTestRunner::initializeProgram(Test *Test) {
   GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(Test);
 
-  auto Handle = ObjectLayer.addObjectSet(ObjectFiles,
-                                         make_unique<SectionMemoryManager>(),
-                                         make_unique<Mutang_GoogleTest_Resolver>());
-
-  auto start = high_resolution_clock::now();
-
   for (auto &Ctor: GTest->GetGlobalCtors()) {
     runStaticCtor(Ctor);
   }
 
+  keepFinalizedObjects();
+  ProgramInitialized = true;
+}
+
+ExecutionResult GoogleTestRunner::runTest(Test *Test, ObjectFiles &ObjectFiles) {
+  GoogleTest_Test *GTest = dyn_cast<GoogleTest_Test>(Test);
+
+  if (loadProgram(ObjectFiles)) {
+    ProgramInitialized = false;
+  }
+
+  /// When the program was initialized by a parent process (see
+  /// initializeProgram) and is still the same, all the tests are already
+  /// registered within GoogleTest and only the filter has to be applied.
+  /// The constructors are not timed either way, otherwise the runs of the
+  /// original program in zygote mode would look faster than the mutants
+  if (!ProgramInitialized) {
+    for (auto &Ctor: GTest->GetGlobalCtors()) {
+      runStaticCtor(Ctor);
+    }
+  }
+
+  auto start = high_resolution_clock::now();
+
   std::string filter = "--gtest_filter=" + GTest->getTestName();
   const char *argv[] = { "mutang", filter.c_str(), NULL };
   int argc = 2;
@@ -186,14 +246,13 @@ ExecutionResult GoogleTestRunner::runTest(Test *Test, ObjectFiles &ObjectFiles)
   uint64_t result = runAllTests(test);
 
   runDestructors();
+  ProgramInitialized = false;
   auto elapsed = high_resolution_clock::now() - start;
 
   //printf("%llu %s\n", result, GTest->getTestName().c_str());
 
   ExecutionResult Result;
-  Result.RunningTime = duration_cast<std::chrono::milliseconds>(elapsed).count();
-
-  ObjectLayer.removeObjectSet(Handle);
+  Result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
 
   if (result == 0) {
     Result.Status = ExecutionStatus::Passed;
@@ -0,0 +1,163 @@
+#include "LoopBudget.h"
+
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+/// The instrumented code refers to these, JIT resolves them
+/// to the host process
+extern "C" uint64_t *mutang_loop_counters = nullptr;
+extern "C" uint64_t mutang_loop_iterations = 0;
+extern "C" uint64_t mutang_loop_budget = 0;
+
+extern "C" void mutang_loop_budget_exceeded() {
+  _exit(LoopBudgetExceededExitCode);
+}
+
+/// Blocks ending with a jump to one of their dominators,
+/// i.e. to the header of a loop they belong to
+static std::vector<BasicBlock *> backEdgeSources(Function &function) {
+  DominatorTree dominatorTree(function);
+
+  std::vector<BasicBlock *> sources;
+  for (auto &block : function) {
+    for (auto successor : successors(&block)) {
+      if (dominatorTree.dominates(successor, &block)) {
+        sources.push_back(&block);
+        break;
+      }
+    }
+  }
+
+  return sources;
+}
+
+const uint64_t LoopBudget::MinimumBudget;
+
+LoopBudget::LoopBudget(uint64_t multiplier)
+  : counters(nullptr), countersSize(0), multiplier(multiplier) {}
+
+LoopBudget::~LoopBudget() {
+  if (counters == nullptr) {
+    return;
+  }
+
+  if (mutang_loop_counters == counters) {
+    mutang_loop_counters = nullptr;
+  }
+
+  munmap(counters, countersSize);
+}
+
+void LoopBudget::instrumentCounters(Module &original, Module &clone) {
+  LLVMContext &context = clone.getContext();
+  Type *counterType = Type::getInt64Ty(context);
+  Constant *countersPointer =
+    clone.getOrInsertGlobal("mutang_loop_counters", counterType->getPointerTo());
+
+  /// The clone has exactly the same layout as the original module
+  auto originalFunction = original.begin();
+  for (auto &function : clone) {
+    Function &originalLLVMFunction = *originalFunction++;
+    if (function.isDeclaration()) {
+      continue;
+    }
+
+    auto sources = backEdgeSources(function);
+    if (sources.empty()) {
+      continue;
+    }
+
+    unsigned index = functions.size();
+    functions.push_back(&originalLLVMFunction);
+    functionIndices[&originalLLVMFunction] = index;
+
+    for (auto block : sources) {
+      IRBuilder<> builder(block->getTerminator());
+      Value *base = builder.CreateLoad(countersPointer);
+      Value *counter = builder.CreateConstGEP1_32(base, index);
+      Value *count = builder.CreateAdd(builder.CreateLoad(counter),
+                                       ConstantInt::get(counterType, 1));
+      builder.CreateStore(count, counter);
+    }
+  }
+}
+
+void LoopBudget::allocateCounters() {
+  assert(counters == nullptr && "Counters are already allocated");
+
+  /// mmap does not accept zero length
+  countersSize = (functions.size() + 1) * sizeof(uint64_t);
+  void *sharedMemory = mmap(NULL,
+                            countersSize,
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS,
+                            -1,
+                            0);
+  assert(sharedMemory != MAP_FAILED && "Can't map memory for loop counters");
+
+  counters = static_cast<uint64_t *>(sharedMemory);
+  mutang_loop_counters = counters;
+  resetCounters();
+}
+
+void LoopBudget::resetCounters() {
+  memset(counters, 0, countersSize);
+}
+
+std::vector<uint64_t> LoopBudget::collectCounts() const {
+  return std::vector<uint64_t>(counters, counters + functions.size());
+}
+
+uint64_t LoopBudget::budgetFor(const std::vector<uint64_t> &counts,
+                               Function *function) const {
+  auto index = functionIndices.find(function);
+  if (index == functionIndices.end() || index->second >= counts.size()) {
+    return MinimumBudget;
+  }
+
+  return std::max(MinimumBudget, counts[index->second] * multiplier);
+}
+
+void LoopBudget::instrumentBudget(Function &function) {
+  Module *module = function.getParent();
+  LLVMContext &context = module->getContext();
+  Type *counterType = Type::getInt64Ty(context);
+
+  Constant *iterations = module->getOrInsertGlobal("mutang_loop_iterations", counterType);
+  Constant *budget = module->getOrInsertGlobal("mutang_loop_budget", counterType);
+  Constant *exceeded =
+    module->getOrInsertFunction("mutang_loop_budget_exceeded",
+                                FunctionType::get(Type::getVoidTy(context), false));
+
+  /// Collected up front: splitting blocks below changes the dominator tree
+  for (auto block : backEdgeSources(function)) {
+    Instruction *terminator = block->getTerminator();
+
+    IRBuilder<> builder(terminator);
+    Value *count = builder.CreateAdd(builder.CreateLoad(iterations),
+                                     ConstantInt::get(counterType, 1));
+    builder.CreateStore(count, iterations);
+    Value *isExceeded = builder.CreateICmpUGT(count, builder.CreateLoad(budget));
+
+    TerminatorInst *exit = SplitBlockAndInsertIfThen(isExceeded, terminator, true);
+    IRBuilder<> exitBuilder(exit);
+    exitBuilder.CreateCall(exceeded);
+  }
+}
+
+void LoopBudget::setBudget(uint64_t budget) {
+  mutang_loop_budget = budget;
+  mutang_loop_iterations = 0;
+}
@@ -0,0 +1,44 @@
+#include "MutationOperators/MutationOperatorRegistry.h"
+
+#include "ConfigParser.h"
+#include "MutationOperators/AddMutationOperator.h"
+#include "MutationOperators/NegateConditionMutationOperator.h"
+#include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
+
+using namespace Mutang;
+
+MutationOperatorRegistry::MutationOperatorRegistry() {
+  registerOperator<AddMutationOperator>();
+  registerOperator<NegateConditionMutationOperator>();
+  registerOperator<RemoveVoidFunctionMutationOperator>();
+}
+
+std::vector<std::string> MutationOperatorRegistry::getIdentifiers() const {
+  std::vector<std::string> identifiers;
+  for (auto &entry : factories) {
+    identifiers.push_back(entry.first);
+  }
+  return identifiers;
+}
+
+std::vector<std::unique_ptr<MutationOperator>>
+MutationOperatorRegistry::createOperators(const std::vector<std::string> &identifiers) const {
+  std::vector<std::unique_ptr<MutationOperator>> operators;
+
+  if (identifiers.empty()) {
+    for (auto &entry : factories) {
+      operators.push_back(entry.second());
+    }
+    return operators;
+  }
+
+  for (auto &identifier : identifiers) {
+    auto factory = factories.find(identifier);
+    if (factory == factories.end()) {
+      configurationError("unknown mutation operator '" + identifier + "'");
+    }
+    operators.push_back(factory->second());
+  }
+
+  return operators;
+}
@@ -0,0 +1,69 @@
+#include "MutationOperators/MutationPointScanner.h"
+#include "MutationOperators/MutationOperatorFilter.h"
+
+#include "Context.h"
+
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+
+#include <iterator>
+
+using namespace llvm;
+using namespace Mutang;
+
+MutationPointScanner::MutationPointScanner(
+    const std::vector<std::unique_ptr<MutationOperator>> &mutationOperators)
+    : operatorsByOpcode(Instruction::OtherOpsEnd) {
+  for (auto &mutationOperator : mutationOperators) {
+    for (auto opcode : mutationOperator->getOpcodes()) {
+      assert(opcode < operatorsByOpcode.size() && "Unexpected opcode");
+      operatorsByOpcode[opcode].push_back(mutationOperator.get());
+    }
+  }
+}
+
+std::vector<std::unique_ptr<MutationPoint>>
+MutationPointScanner::scan(const Context &context,
+                           llvm::Function &function,
+                           MutationOperatorFilter &filter) const {
+  std::vector<std::unique_ptr<MutationPoint>> mutationPoints;
+
+  Module *module = function.getParent();
+  auto functionIt = std::find_if(module->begin(), module->end(),
+                                 [&function] (llvm::Function &f) {
+                                   return &f == &function;
+                                 });
+  assert(functionIt != module->end() && "Expected function to be found in module");
+  int functionIndex = std::distance(module->begin(), functionIt);
+
+  MutangModule *mutangModule =
+    context.moduleWithIdentifier(module->getModuleIdentifier());
+
+  int basicBlockIndex = 0;
+  for (auto &basicBlock : function) {
+    int instructionIndex = 0;
+
+    for (auto &instruction : basicBlock) {
+      auto &candidates = operatorsByOpcode[instruction.getOpcode()];
+
+      if (!candidates.empty() && !filter.shouldSkipInstruction(&instruction)) {
+        for (auto mutationOperator : candidates) {
+          if (!mutationOperator->canBeApplied(instruction)) {
+            continue;
+          }
+
+          MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
+          mutationPoints.emplace_back(make_unique<MutationPoint>(mutationOperator,
+                                                                 address,
+                                                                 &instruction,
+                                                                 mutangModule));
+        }
+      }
+
+      instructionIndex++;
+    }
+    basicBlockIndex++;
+  }
+
+  return mutationPoints;
+}
@@ -1,7 +1,5 @@
 #include "MutationOperators/NegateConditionMutationOperator.h"
-#include "MutationOperators/MutationOperatorFilter.h"
 
-#include "Context.h"
 #include "Logger.h"
 #include "MutationPoint.h"
 
@@ -37,20 +35,6 @@ using namespace Mutang;
 /// pattern as `tobool`'s `X`.
 ///
 
-static int GetFunctionIndex(llvm::Function *function) {
-  auto PM = function->getParent();
-
-  auto FII = std::find_if(PM->begin(), PM->end(),
-                          [function] (llvm::Function &f) {
-                            return &f == function;
-                          });
-
-  assert(FII != PM->end() && "Expected function to be found in module");
-  int FIndex = std::distance(PM->begin(), FII);
-
-  return FIndex;
-}
-
 llvm::CmpInst::Predicate
 NegateConditionMutationOperator::negatedCmpInstPredicate(llvm::CmpInst::Predicate predicate) {
 
@@ -188,36 +172,6 @@ NegateConditionMutationOperator::negatedCmpInstPredicate(llvm::CmpInst::Predicat
   }
 }
 
-std::vector<MutationPoint *>
-NegateConditionMutationOperator::getMutationPoints(const Context &context,
-                                                   llvm::Function *function,
-                                                   MutationOperatorFilter &filter) {
-  int functionIndex = GetFunctionIndex(function);
-  int basicBlockIndex = 0;
-
-  std::vector<MutationPoint *> mutationPoints;
-
-  for (auto &basicBlock : function->getBasicBlockList()) {
-
-    int instructionIndex = 0;
-
-    for (auto &instruction : basicBlock.getInstList()) {
-      if (canBeApplied(instruction) && !filter.shouldSkipInstruction(&instruction)) {
-        auto moduleID = instruction.getModule()->getModuleIdentifier();
-        MutangModule *module = context.moduleWithIdentifier(moduleID);
-
-        MutationPointAddress address(functionIndex, basicBlockIndex, instructionIndex);
-        auto mutationPoint = new MutationPoint(this, address, &instruction, module);
-        mutationPoints.push_back(mutationPoint);
-      }
-      instructionIndex++;
-    }
-    basicBlockIndex++;
-  }
-
-  return mutationPoints;
-}
-
 bool NegateConditionMutationOperator::canBeApplied(Value &V) {
 
   if (CmpInst *cmpOp = dyn_cast<CmpInst>(&V)) {
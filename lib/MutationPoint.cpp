@@ -48,14 +48,23 @@ Value *MutationPoint::getOriginalValue() const {
   return OriginalValue;
 }
 
+MutangModule *MutationPoint::getOriginalModule() const {
+  return module;
+}
+
 void MutationPoint::applyMutation(llvm::Module *M) {
   mutationOperator->applyMutation(M, Address, *OriginalValue);
 }
 
 llvm::object::OwningBinary<llvm::object::ObjectFile> MutationPoint::applyMutation(Compiler &compiler) {
+  auto copyForMutation = cloneModuleAndApplyMutation();
+  return compiler.compileModule(copyForMutation.get());
+}
+
+std::unique_ptr<llvm::Module> MutationPoint::cloneModuleAndApplyMutation() {
   auto copyForMutation = CloneModule(module->getModule());
   mutationOperator->applyMutation(copyForMutation.get(), Address, *OriginalValue);
-  return compiler.compileModule(copyForMutation.get());
+  return copyForMutation;
 }
 
 std::string MutationPoint::getUniqueIdentifier() {
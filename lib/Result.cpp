@@ -5,53 +5,68 @@
 #include "llvm/IR/DebugInfoMetadata.h"
 #include "llvm/IR/Function.h"
 
-#include <sstream>
 #include <string>
 
 using namespace Mutang;
 using namespace llvm;
 
-std::vector<std::string> Result::calculateCallerPath(MutationResult *mutationResult) {
-  Testee *currentTestee = mutationResult->getTestee();
-
-  std::vector<std::string> callerPath;
+int Result::locationOfInstruction(Instruction *instruction) {
+  auto cached = instructionLocations.find(instruction);
+  if (cached != instructionLocations.end()) {
+    return cached->second;
+  }
 
   /// Currently we don't print functions, only "file:line". Later we will and
   /// for that we will have to demangle them.
+  std::string location = instruction->getDebugLoc()->getFilename().str()
+    + ":" + std::to_string(instruction->getDebugLoc()->getLine());
+
+  auto inserted = locationIndices.insert(std::make_pair(location,
+                                                        (int)locations.size()));
+  if (inserted.second) {
+    locations.push_back(location);
+  }
+
+  int index = inserted.first->second;
+  instructionLocations.insert(std::make_pair(instruction, index));
+  return index;
+}
 
-  /// Last path component: mutation point itself.
-  auto mutationPoint = mutationResult->getMutationPoint();
-  Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
-  const std::string fileName = instruction->getDebugLoc()->getFilename();
-  const std::string line = std::to_string(instruction->getDebugLoc()->getLine());
+/// The path of a testee is the path of its caller followed by the call site
+/// within the caller. The path of a test (it has no caller) is empty.
+const std::vector<int> &Result::calculateTesteeCallerPath(Testee *testee) {
+  auto cached = testeeCallerPaths.find(testee);
+  if (cached != testeeCallerPaths.end()) {
+    return cached->second;
+  }
 
-  ///Function *function = instruction->getFunction();
-  ///assert(function && "Expected function");
-  ///std::string functionName = function->getName().str();
+  std::vector<int> callerPath;
 
-  std::stringstream mpComponentAsStream;
-  mpComponentAsStream << fileName;
-  mpComponentAsStream << ":";
-  mpComponentAsStream << line;
-  callerPath.push_back(mpComponentAsStream.str());
+  Testee *callerTestee = testee->getCallerTestee();
+  if (callerTestee != nullptr) {
+    callerPath = calculateTesteeCallerPath(callerTestee);
+    callerPath.push_back(locationOfInstruction(testee->getCallerInstruction()));
+  }
 
-  // The following loop stops on test as it does not have a caller.
-  do {
-    Instruction *instruction = currentTestee->getCallerInstruction();
+  return testeeCallerPaths.insert(std::make_pair(testee, callerPath)).first->second;
+}
 
-    const std::string fileName = instruction->getDebugLoc()->getFilename();
-    const std::string line = std::to_string(instruction->getDebugLoc()->getLine());
+std::vector<std::string> Result::calculateCallerPath(MutationResult *mutationResult) {
+  const std::vector<int> &testeePath =
+    calculateTesteeCallerPath(mutationResult->getTestee());
 
-    std::stringstream callerComponentAsStream;
-    callerComponentAsStream << fileName;
-    callerComponentAsStream << ":";
-    callerComponentAsStream << line;
-    callerPath.push_back(callerComponentAsStream.str());
+  /// Last path component: mutation point itself.
+  auto mutationPoint = mutationResult->getMutationPoint();
+  Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
+  int mutationPointLocation = locationOfInstruction(instruction);
 
-    currentTestee = currentTestee->getCallerTestee();
-  } while (currentTestee->getCallerTestee() != nullptr);
+  std::vector<std::string> callerPath;
+  callerPath.reserve(testeePath.size() + 1);
 
-  std::reverse(std::begin(callerPath), std::end(callerPath));
+  for (int location : testeePath) {
+    callerPath.push_back(locations[location]);
+  }
+  callerPath.push_back(locations[mutationPointLocation]);
 
   return callerPath;
 }
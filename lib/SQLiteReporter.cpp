@@ -1,8 +1,11 @@
 #include "SQLiteReporter.h"
 
+#include "Config.h"
+#include "FunctionHasher.h"
 #include "Logger.h"
 #include "Result.h"
 #include "TestResult.h"
+#include "Trace.h"
 
 #include "MutationOperators/MutationOperator.h"
 
@@ -10,8 +13,12 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <map>
 #include <sqlite3.h>
 #include <sstream>
 #include <string>
@@ -22,6 +29,7 @@ using namespace Mutang;
 using namespace llvm;
 
 static void createTables(sqlite3 *database);
+static void createIndexes(sqlite3 *database);
 
 static void assume(bool condition, const char *assumption) {
   if (condition) {
@@ -46,7 +54,90 @@ void sqlite_exec(sqlite3 *database, const char *sql) {
   }
 }
 
-SQLiteReporter::SQLiteReporter() {
+static sqlite3_stmt *sqlite_prepare(sqlite3 *database, const char *sql) {
+  sqlite3_stmt *statement = nullptr;
+  int result = sqlite3_prepare_v2(database, sql, -1, &statement, nullptr);
+  if (result != SQLITE_OK) {
+    Logger::error() << "Cannot prepare " << sql << '\n';
+    Logger::error() << "Reason: '" << sqlite3_errmsg(database) << "'\n";
+    Logger::error() << "Shutting down\n";
+    exit(18);
+  }
+  return statement;
+}
+
+/// Executes prepared statement and resets it so that it can be bound again
+static void sqlite_step(sqlite3 *database, sqlite3_stmt *statement) {
+  int result = sqlite3_step(statement);
+  if (result != SQLITE_DONE) {
+    Logger::error() << "Cannot execute " << sqlite3_sql(statement) << '\n';
+    Logger::error() << "Reason: '" << sqlite3_errmsg(database) << "'\n";
+  }
+  assume(result == SQLITE_DONE, "SQLite error: Expected statement to succeed.");
+
+  sqlite3_clear_bindings(statement);
+  sqlite3_reset(statement);
+}
+
+static sqlite3_int64 insertExecutionResult(sqlite3 *database,
+                                           sqlite3_stmt *statement,
+                                           const ExecutionResult &result) {
+  sqlite3_bind_int(statement, 1, result.Status);
+  sqlite3_bind_int64(statement, 2, result.RunningTime);
+  sqlite3_bind_text(statement, 3, result.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(statement, 4, result.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(statement, 5, result.Usage.UserTime);
+  sqlite3_bind_int64(statement, 6, result.Usage.SystemTime);
+  sqlite3_bind_int64(statement, 7, result.Usage.MaxRSS);
+  sqlite3_bind_int64(statement, 8, result.Usage.MajorFaults);
+  sqlite3_bind_int64(statement, 9, result.Usage.MinorFaults);
+  sqlite3_bind_int64(statement, 10, result.Usage.ContextSwitches);
+  sqlite_step(database, statement);
+
+  return sqlite3_last_insert_rowid(database);
+}
+
+static std::string MD5HashFromString(StringRef string) {
+  MD5 hasher;
+  hasher.update(string);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> result;
+  MD5::stringifyResult(hash, result);
+  return result.str();
+}
+
+/// Functions with identical bodies (e.g. the same inline function coming
+/// from several modules) share a single function_ir row.
+static sqlite3_int64 insertFunctionIR(sqlite3 *database,
+                                      sqlite3_stmt *statement,
+                                      StringMap<sqlite3_int64> &idsByHash,
+                                      Function *function) {
+  std::string functionIR;
+  raw_string_ostream f_ostream(functionIR);
+  function->print(f_ostream);
+  f_ostream.flush();
+
+  std::string functionHash = MD5HashFromString(functionIR);
+  auto existing = idsByHash.find(functionHash);
+  if (existing != idsByHash.end()) {
+    return existing->second;
+  }
+
+  sqlite3_bind_text(statement, 1, functionHash.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(statement, 2, functionIR.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite_step(database, statement);
+
+  sqlite3_int64 functionIRID = sqlite3_last_insert_rowid(database);
+  idsByHash[functionHash] = functionIRID;
+  return functionIRID;
+}
+
+SQLiteReporter::SQLiteReporter(const Config &config) : SQLiteReporter() {
+  emitDebugInfo = config.shouldEmitDebugInfo();
+}
+
+SQLiteReporter::SQLiteReporter() : emitDebugInfo(true) {
   char wd[MAXPATHLEN] = { 0 };
   getwd(wd);
   std::string currentDirectory(wd);
@@ -64,7 +155,13 @@ std::string Mutang::SQLiteReporter::getDatabasePath() {
   return databasePath;
 }
 
+void Mutang::SQLiteReporter::setDatabasePath(const std::string &path) {
+  databasePath = path;
+}
+
 void Mutang::SQLiteReporter::reportResults(const std::unique_ptr<Result> &result) {
+  TraceScope scope("report results", "report");
+
   std::string databasePath = getDatabasePath();
 
   sqlite3 *database;
@@ -72,134 +169,152 @@ void Mutang::SQLiteReporter::reportResults(const std::unique_ptr<Result> &result
 
   createTables(database);
 
-  for (auto &testResult : result->getTestResults()) {
-    std::string testID = testResult->getTestName();
+  /// All rows are inserted within a single transaction: otherwise SQLite
+  /// syncs the journal on every INSERT which dominates the reporting time.
+  sqlite_exec(database, "BEGIN TRANSACTION;");
+
+  sqlite3_stmt *insertExecutionResultStmt =
+    sqlite_prepare(database, "INSERT INTO execution_result VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+  sqlite3_stmt *insertTestStmt =
+    sqlite_prepare(database, "INSERT INTO test (test_name, execution_result_id, testees_hash) VALUES (?, ?, ?);");
+  sqlite3_stmt *insertMutationPointStmt =
+    sqlite_prepare(database, "INSERT INTO mutation_point (mutation_operator, module_name, function_name, function_index, basic_block_index, instruction_index, filename, line_number, column_number, __tmp_caller_path, unique_id, stable_id) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+  sqlite3_stmt *insertFunctionIRStmt =
+    sqlite_prepare(database, "INSERT INTO function_ir (hash, ir) VALUES (?, ?);");
+  sqlite3_stmt *insertMutationPointDebugStmt =
+    sqlite_prepare(database, "INSERT INTO mutation_point_debug VALUES (?, ?, ?, ?);");
+  sqlite3_stmt *insertMutationResultStmt =
+    sqlite_prepare(database, "INSERT INTO mutation_result VALUES (?, ?, ?, ?);");
+
+  /// Rows which are referenced by several mutation results are inserted once,
+  /// these maps hold their integer keys.
+  std::map<MutationPoint *, sqlite3_int64> mutationPointIDs;
+
+  /// IR is printed at most once per function and per basic block no matter
+  /// how many mutation points or tests refer to them.
+  std::map<Function *, sqlite3_int64> functionIRIDs;
+  StringMap<sqlite3_int64> functionIRIDsByHash;
+  std::map<BasicBlock *, std::string> basicBlockIRs;
+
+  /// Stable identifiers let a later run reuse these results, see Baseline
+  FunctionHasher functionHasher;
 
+  for (auto &testResult : result->getTestResults()) {
     ExecutionResult testExecutionResult = testResult->getOriginalTestResult();
-    std::string insertResultSQL = std::string("INSERT INTO execution_result VALUES (")
-    + "'" + std::to_string(testExecutionResult.Status) + "',"
-    + "'" + std::to_string(testExecutionResult.RunningTime) + "',"
-    + "'" + testExecutionResult.stdoutOutput + "',"
-    + "'" + testExecutionResult.stderrOutput + "');";
-    sqlite_exec(database, insertResultSQL.c_str());
-    int testResultID = sqlite3_last_insert_rowid(database);
-
-    std::string insertTestSQL = std::string("INSERT INTO test VALUES (")
-    + "'" + testID + "',"
-    + "'" + std::to_string(testResultID) + "');";
-    sqlite_exec(database, insertTestSQL.c_str());
+    sqlite3_int64 testResultID = insertExecutionResult(database,
+                                                       insertExecutionResultStmt,
+                                                       testExecutionResult);
 
-    for (auto &mutation : testResult->getMutationResults()) {
-      std::vector<std::string> callerPath = result.get()->calculateCallerPath(mutation.get());
+    sqlite3_bind_text(insertTestStmt, 1, testResult->getTestName().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(insertTestStmt, 2, testResultID);
+    sqlite3_bind_text(insertTestStmt, 3, testResult->getTesteesHash().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite_step(database, insertTestStmt);
+    sqlite3_int64 testID = sqlite3_last_insert_rowid(database);
 
-      std::string callerPathAsString = getCallerPathAsString(callerPath);
-
-      /// Mutation Point
+    for (auto &mutation : testResult->getMutationResults()) {
       auto mutationPoint = mutation->getMutationPoint();
-      Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
-      std::string insertMutationPointSQL = std::string("INSERT OR IGNORE INTO mutation_point VALUES (")
-      + "'" + mutationPoint->getOperator()->uniqueID() + "',"
-      + "'" + instruction->getParent()->getParent()->getParent()->getModuleIdentifier() + "',"
-      + "'" + instruction->getParent()->getParent()->getName().str() + "',"
-      + "'" + std::to_string(mutationPoint->getAddress().getFnIndex()) + "',"
-      + "'" + std::to_string(mutationPoint->getAddress().getBBIndex()) + "',"
-      + "'" + std::to_string(mutationPoint->getAddress().getIIndex()) + "',"
-      + "'" + instruction->getDebugLoc()->getFilename().str() + "',"
-      + "'" + std::to_string(instruction->getDebugLoc()->getLine()) + "',"
-      + "'" + std::to_string(instruction->getDebugLoc()->getColumn()) + "',"
-      + "'" + callerPathAsString + "',"
-      + "'" + mutationPoint->getUniqueIdentifier() + "'"+
-      + ");";
-
-      sqlite_exec(database, insertMutationPointSQL.c_str());
-      std::string mutationPointID = mutationPoint->getUniqueIdentifier();
-
-      {
-        std::string function;
-        llvm::raw_string_ostream f_ostream(function);
-        instruction->getFunction()->print(f_ostream);
-
-        std::string basicBlock;
-        llvm::raw_string_ostream bb_ostream(basicBlock);
-        instruction->getParent()->print(bb_ostream);
-
-        std::string instr;
-        llvm::raw_string_ostream i_ostream(instr);
-        instruction->print(i_ostream);
-
-        std::string insertMutationPointDebugSQL = std::string("INSERT OR IGNORE INTO mutation_point_debug VALUES (")
-        + "'" + instruction->getDebugLoc()->getFilename().str() + "',"
-        + "'" + std::to_string(instruction->getDebugLoc()->getLine()) + "',"
-        + "'" + std::to_string(instruction->getDebugLoc()->getColumn()) + "',"
-        + "'" + f_ostream.str() + "',"
-        + "'" + bb_ostream.str() + "',"
-        + "'" + i_ostream.str() + "',"
-        + "'" + mutationPoint->getUniqueIdentifier() + "'"+
-        + ");";
-
-        sqlite3_stmt *statement = NULL;
-        int statement_prepare_result =
-        sqlite3_prepare_v2(database,
-                           insertMutationPointDebugSQL.c_str(),
-                           insertMutationPointDebugSQL.size(),
-                           &statement,
-                           NULL);
-
-        assume(statement_prepare_result == SQLITE_OK, "SQLite error: Expected finalize of debug mutation point statement to succeed.");
-
-        int insertion_result = sqlite3_step(statement);
-        assume(insertion_result == SQLITE_DONE, "SQLite error: Expected insertion of debug mutation point to succeed.");
-
-        int finalize_result = sqlite3_finalize(statement);
-        assume(finalize_result == SQLITE_OK, "SQLite error: Expected finalize of debug mutation point statement to succeed.");
+
+      auto existingPoint = mutationPointIDs.find(mutationPoint);
+      sqlite3_int64 mutationPointID = 0;
+      if (existingPoint != mutationPointIDs.end()) {
+        mutationPointID = existingPoint->second;
+      } else {
+        std::vector<std::string> callerPath = result.get()->calculateCallerPath(mutation.get());
+        std::string callerPathAsString = getCallerPathAsString(callerPath);
+
+        /// Mutation Point
+        Instruction *instruction = dyn_cast<Instruction>(mutationPoint->getOriginalValue());
+        Function *function = instruction->getFunction();
+
+        std::string operatorID = mutationPoint->getOperator()->uniqueID();
+        std::string moduleID = function->getParent()->getModuleIdentifier();
+        std::string functionName = function->getName().str();
+        std::string fileName = instruction->getDebugLoc()->getFilename().str();
+        std::string uniqueID = mutationPoint->getUniqueIdentifier();
+        std::string stableID = functionHasher.stableIdentifier(mutationPoint);
+        MutationPointAddress address = mutationPoint->getAddress();
+
+        sqlite3_bind_text(insertMutationPointStmt, 1, operatorID.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insertMutationPointStmt, 2, moduleID.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insertMutationPointStmt, 3, functionName.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(insertMutationPointStmt, 4, address.getFnIndex());
+        sqlite3_bind_int(insertMutationPointStmt, 5, address.getBBIndex());
+        sqlite3_bind_int(insertMutationPointStmt, 6, address.getIIndex());
+        sqlite3_bind_text(insertMutationPointStmt, 7, fileName.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(insertMutationPointStmt, 8, instruction->getDebugLoc()->getLine());
+        sqlite3_bind_int(insertMutationPointStmt, 9, instruction->getDebugLoc()->getColumn());
+        sqlite3_bind_text(insertMutationPointStmt, 10, callerPathAsString.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insertMutationPointStmt, 11, uniqueID.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insertMutationPointStmt, 12, stableID.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite_step(database, insertMutationPointStmt);
+
+        mutationPointID = sqlite3_last_insert_rowid(database);
+        mutationPointIDs.insert(std::make_pair(mutationPoint, mutationPointID));
+
+        if (emitDebugInfo) {
+          sqlite3_int64 functionIRID = 0;
+          auto existingFunction = functionIRIDs.find(function);
+          if (existingFunction != functionIRIDs.end()) {
+            functionIRID = existingFunction->second;
+          } else {
+            functionIRID = insertFunctionIR(database,
+                                            insertFunctionIRStmt,
+                                            functionIRIDsByHash,
+                                            function);
+            functionIRIDs.insert(std::make_pair(function, functionIRID));
+          }
+
+          BasicBlock *basicBlock = instruction->getParent();
+          auto existingBasicBlock = basicBlockIRs.find(basicBlock);
+          if (existingBasicBlock == basicBlockIRs.end()) {
+            std::string basicBlockIR;
+            raw_string_ostream bb_ostream(basicBlockIR);
+            basicBlock->print(bb_ostream);
+            bb_ostream.flush();
+
+            existingBasicBlock =
+              basicBlockIRs.insert(std::make_pair(basicBlock, basicBlockIR)).first;
+          }
+
+          std::string instr;
+          raw_string_ostream i_ostream(instr);
+          instruction->print(i_ostream);
+
+          sqlite3_bind_int64(insertMutationPointDebugStmt, 1, mutationPointID);
+          sqlite3_bind_int64(insertMutationPointDebugStmt, 2, functionIRID);
+          sqlite3_bind_text(insertMutationPointDebugStmt, 3, existingBasicBlock->second.c_str(), -1, SQLITE_TRANSIENT);
+          sqlite3_bind_text(insertMutationPointDebugStmt, 4, i_ostream.str().c_str(), -1, SQLITE_TRANSIENT);
+          sqlite_step(database, insertMutationPointDebugStmt);
+        }
       }
 
       /// Execution result
       ExecutionResult mutationExecutionResult = mutation->getExecutionResult();
-      std::string insertMutationExecutionResultSQL = std::string("INSERT INTO execution_result VALUES (")
-      + "'" + std::to_string(mutationExecutionResult.Status) + "',"
-      + "'" + std::to_string(mutationExecutionResult.RunningTime) + "',"
-      + "" + "?" + ","
-      + "" + "?" + ");";
-
-      sqlite3_stmt *execution_result_statement = NULL;
-      int execution_result_statement_prepare_result =
-        sqlite3_prepare_v2(database,
-                           insertMutationExecutionResultSQL.c_str(),
-                           insertMutationExecutionResultSQL.size(),
-                           &execution_result_statement,
-                           NULL);
-
-      assume(execution_result_statement_prepare_result == SQLITE_OK,
-             "SQLite error: Expected preparation of execution result statement to succeed.");
-
-      if (execution_result_statement_prepare_result != SQLITE_OK) {
-        Logger::error() << insertMutationExecutionResultSQL << '\n';
-        Logger::error() << sqlite3_errmsg(database) << '\n';
-      }
-
-      sqlite3_bind_text(execution_result_statement, 1, mutationExecutionResult.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
-      sqlite3_bind_text(execution_result_statement, 2, mutationExecutionResult.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
-
-      int execution_result_insertion_result = sqlite3_step(execution_result_statement);
-      assume(execution_result_insertion_result == SQLITE_DONE,
-             "SQLite error: Expected insertion of execution result to succeed.");
+      sqlite3_int64 mutationExecutionResultID =
+        insertExecutionResult(database,
+                              insertExecutionResultStmt,
+                              mutationExecutionResult);
+
+      sqlite3_bind_int64(insertMutationResultStmt, 1, mutationExecutionResultID);
+      sqlite3_bind_int64(insertMutationResultStmt, 2, testID);
+      sqlite3_bind_int64(insertMutationResultStmt, 3, mutationPointID);
+      sqlite3_bind_int(insertMutationResultStmt, 4, mutation->getMutationDistance());
+      sqlite_step(database, insertMutationResultStmt);
+    }
+  }
 
-      int execution_result_statement_finalize_result
-        = sqlite3_finalize(execution_result_statement);
-      assume(execution_result_statement_finalize_result == SQLITE_OK,
-             "SQLite error: Expected finalize of execution result statement to succeed.");
+  sqlite3_finalize(insertExecutionResultStmt);
+  sqlite3_finalize(insertTestStmt);
+  sqlite3_finalize(insertMutationPointStmt);
+  sqlite3_finalize(insertFunctionIRStmt);
+  sqlite3_finalize(insertMutationPointDebugStmt);
+  sqlite3_finalize(insertMutationResultStmt);
 
-      int mutationExecutionResultID = sqlite3_last_insert_rowid(database);
-      std::string insertMutationResultSQL = std::string("INSERT INTO mutation_result VALUES (")
-          + "'" + std::to_string(mutationExecutionResultID) + "',"
-          + "'" + testID + "',"
-          + "'" + mutationPointID + "',"
-          + "'" + std::to_string(mutation->getMutationDistance()) + "');";
+  /// Indexes are cheaper to build once over the loaded data than to maintain
+  /// on every insertion.
+  createIndexes(database);
 
-      sqlite_exec(database, insertMutationResultSQL.c_str());
-    }
-  }
+  sqlite_exec(database, "COMMIT TRANSACTION;");
 
   sqlite3_close(database);
 
@@ -226,20 +341,37 @@ std::string SQLiteReporter::getCallerPathAsString(const std::vector<std::string>
 
 #pragma mark - Database Schema
 
+/// Bump whenever the schema below changes so that consumers of the database
+/// can tell which layout they are reading.
+static const int SchemaVersion = 4;
+
 static const char *CreateTables = R"CreateTables(
+CREATE TABLE schema_version (
+  version INT
+);
+
 CREATE TABLE execution_result (
   status INT,
-  duration INT,
+  duration INT, -- microseconds
   stdout TEXT,
-  stderr TEXT
+  stderr TEXT,
+  user_time INT, -- microseconds
+  system_time INT, -- microseconds
+  max_rss INT, -- kilobytes
+  major_faults INT,
+  minor_faults INT,
+  context_switches INT
 );
 
 CREATE TABLE test (
+  id INTEGER PRIMARY KEY,
   test_name TEXT,
-  execution_result_id INT
+  execution_result_id INT,
+  testees_hash TEXT
 );
 
 CREATE TABLE mutation_point (
+  id INTEGER PRIMARY KEY,
   mutation_operator TEXT,
   module_name TEXT,
   function_name TEXT,
@@ -250,26 +382,238 @@ CREATE TABLE mutation_point (
   line_number INT,
   column_number INT,
   __tmp_caller_path TEXT,
-  unique_id TEXT UNIQUE
+  unique_id TEXT UNIQUE,
+  stable_id TEXT
 );
 
 CREATE TABLE mutation_result (
   execution_result_id INT,
-  test_id TEXT,
-  mutation_point_id TEXT,
+  test_id INT,
+  mutation_point_id INT,
   mutation_distance INT
 );
 
+CREATE TABLE function_ir (
+  id INTEGER PRIMARY KEY,
+  hash TEXT UNIQUE,
+  ir TEXT
+);
+
 CREATE TABLE mutation_point_debug (
-  filename TEXT,
-  line_number INT,
-  column_number INT,
-  function TEXT,
+  mutation_point_id INT UNIQUE,
+  function_ir_id INT,
   basic_block TEXT,
-  instruction INT,
-  unique_id TEXT UNIQUE);
+  instruction TEXT
+);
 )CreateTables";
 
+static const char *CreateIndexes = R"CreateIndexes(
+CREATE INDEX mutation_result_test_id_index ON mutation_result(test_id);
+CREATE INDEX mutation_result_mutation_point_id_index ON mutation_result(mutation_point_id);
+CREATE INDEX mutation_result_execution_result_id_index ON mutation_result(execution_result_id);
+CREATE INDEX test_execution_result_id_index ON test(execution_result_id);
+CREATE INDEX mutation_point_debug_function_ir_id_index ON mutation_point_debug(function_ir_id);
+)CreateIndexes";
+
 static void createTables(sqlite3 *database) {
   sqlite_exec(database, CreateTables);
+
+  std::string insertVersionSQL = "INSERT INTO schema_version VALUES ("
+    + std::to_string(SchemaVersion) + ");";
+  sqlite_exec(database, insertVersionSQL.c_str());
+}
+
+static void createIndexes(sqlite3 *database) {
+  sqlite_exec(database, CreateIndexes);
+}
+
+#pragma mark - Merging Shards
+
+/// Rows are matched by their natural keys: tests by name, mutation points
+/// by unique identifier and function IR by hash. Execution results are not
+/// shared between rows, so each one is copied with a new row id.
+static const char *MergeShardPoints = R"MergeShardPoints(
+INSERT OR IGNORE INTO mutation_point (mutation_operator, module_name, function_name, function_index, basic_block_index, instruction_index, filename, line_number, column_number, __tmp_caller_path, unique_id, stable_id)
+  SELECT mutation_operator, module_name, function_name, function_index, basic_block_index, instruction_index, filename, line_number, column_number, __tmp_caller_path, unique_id, stable_id
+  FROM shard.mutation_point;
+
+INSERT OR IGNORE INTO function_ir (hash, ir)
+  SELECT hash, ir FROM shard.function_ir;
+
+INSERT OR IGNORE INTO mutation_point_debug
+  SELECT main_point.id, main_ir.id, debug.basic_block, debug.instruction
+  FROM shard.mutation_point_debug AS debug
+  JOIN shard.mutation_point AS shard_point ON shard_point.id = debug.mutation_point_id
+  JOIN main.mutation_point AS main_point ON main_point.unique_id = shard_point.unique_id
+  JOIN shard.function_ir AS shard_ir ON shard_ir.id = debug.function_ir_id
+  JOIN main.function_ir AS main_ir ON main_ir.hash = shard_ir.hash;
+)MergeShardPoints";
+
+static const char *SelectShardTests = R"SelectShardTests(
+SELECT execution_result.status, execution_result.duration,
+       execution_result.stdout, execution_result.stderr,
+       execution_result.user_time, execution_result.system_time,
+       execution_result.max_rss, execution_result.major_faults,
+       execution_result.minor_faults, execution_result.context_switches,
+       test.test_name, test.testees_hash
+FROM shard.test AS test
+JOIN shard.execution_result AS execution_result ON execution_result.rowid = test.execution_result_id
+WHERE test.test_name NOT IN (SELECT test_name FROM main.test)
+ORDER BY test.id;
+)SelectShardTests";
+
+static std::string columnText(sqlite3_stmt *statement, int column) {
+  const unsigned char *text = sqlite3_column_text(statement, column);
+  return text ? (const char *)text : "";
+}
+
+static ExecutionResult selectExecutionResult(sqlite3_stmt *statement) {
+  ExecutionResult result;
+  result.Status = ExecutionStatus(sqlite3_column_int(statement, 0));
+  result.RunningTime = sqlite3_column_int64(statement, 1);
+  result.stdoutOutput = columnText(statement, 2);
+  result.stderrOutput = columnText(statement, 3);
+  result.Usage.UserTime = sqlite3_column_int64(statement, 4);
+  result.Usage.SystemTime = sqlite3_column_int64(statement, 5);
+  result.Usage.MaxRSS = sqlite3_column_int64(statement, 6);
+  result.Usage.MajorFaults = sqlite3_column_int64(statement, 7);
+  result.Usage.MinorFaults = sqlite3_column_int64(statement, 8);
+  result.Usage.ContextSwitches = sqlite3_column_int64(statement, 9);
+  return result;
+}
+
+static const char *SelectShardMutationResults = R"SelectShardMutationResults(
+SELECT execution_result.status, execution_result.duration,
+       execution_result.stdout, execution_result.stderr,
+       execution_result.user_time, execution_result.system_time,
+       execution_result.max_rss, execution_result.major_faults,
+       execution_result.minor_faults, execution_result.context_switches,
+       main_test.id, main_point.id, mutation_result.mutation_distance
+FROM shard.mutation_result AS mutation_result
+JOIN shard.execution_result AS execution_result ON execution_result.rowid = mutation_result.execution_result_id
+JOIN shard.test AS shard_test ON shard_test.id = mutation_result.test_id
+JOIN main.test AS main_test ON main_test.test_name = shard_test.test_name
+JOIN shard.mutation_point AS shard_point ON shard_point.id = mutation_result.mutation_point_id
+JOIN main.mutation_point AS main_point ON main_point.unique_id = shard_point.unique_id
+WHERE NOT EXISTS (SELECT 1 FROM main.mutation_result AS merged
+                  WHERE merged.test_id = main_test.id
+                    AND merged.mutation_point_id = main_point.id);
+)SelectShardMutationResults";
+
+/// A mutation result of a shard with the ids of its test and mutation
+/// point in the merged database
+struct ShardMutationResult {
+  ExecutionResult result;
+  sqlite3_int64 testID;
+  sqlite3_int64 mutationPointID;
+  int mutationDistance;
+};
+
+void Mutang::SQLiteReporter::mergeDatabases(const std::vector<std::string> &shardDatabasePaths) {
+  std::string databasePath = getDatabasePath();
+
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  createTables(database);
+
+  sqlite3_stmt *attachStmt = sqlite_prepare(database, "ATTACH DATABASE ? AS shard;");
+
+  for (auto &shardPath : shardDatabasePaths) {
+    sqlite3_bind_text(attachStmt, 1, shardPath.c_str(), -1, SQLITE_TRANSIENT);
+    int attached = sqlite3_step(attachStmt);
+    sqlite3_clear_bindings(attachStmt);
+    sqlite3_reset(attachStmt);
+    if (attached != SQLITE_DONE) {
+      Logger::error() << "Skipping '" << shardPath << "': "
+                      << sqlite3_errmsg(database) << "\n";
+      continue;
+    }
+
+    sqlite3_stmt *versionStmt =
+      sqlite_prepare(database, "SELECT version FROM shard.schema_version;");
+    int version = 0;
+    if (sqlite3_step(versionStmt) == SQLITE_ROW) {
+      version = sqlite3_column_int(versionStmt, 0);
+    }
+    sqlite3_finalize(versionStmt);
+
+    if (version != SchemaVersion) {
+      Logger::error() << "Skipping '" << shardPath << "': schema version "
+                      << version << ", expected " << SchemaVersion << "\n";
+      sqlite_exec(database, "DETACH DATABASE shard;");
+      continue;
+    }
+
+    sqlite_exec(database, "BEGIN TRANSACTION;");
+
+    sqlite3_stmt *insertExecutionResultStmt =
+      sqlite_prepare(database, "INSERT INTO main.execution_result VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    sqlite3_stmt *insertTestStmt =
+      sqlite_prepare(database, "INSERT INTO main.test (test_name, execution_result_id, testees_hash) VALUES (?, ?, ?);");
+    sqlite3_stmt *insertMutationResultStmt =
+      sqlite_prepare(database, "INSERT INTO main.mutation_result VALUES (?, ?, ?, ?);");
+
+    /// Tests first: they are selected before any of them is inserted
+    std::vector<std::pair<ExecutionResult, std::pair<std::string, std::string>>> tests;
+    sqlite3_stmt *selectStmt = sqlite_prepare(database, SelectShardTests);
+    while (sqlite3_step(selectStmt) == SQLITE_ROW) {
+      tests.push_back(std::make_pair(selectExecutionResult(selectStmt),
+                                     std::make_pair(columnText(selectStmt, 10),
+                                                    columnText(selectStmt, 11))));
+    }
+    sqlite3_finalize(selectStmt);
+
+    for (auto &test : tests) {
+      sqlite3_int64 testResultID = insertExecutionResult(database,
+                                                         insertExecutionResultStmt,
+                                                         test.first);
+      sqlite3_bind_text(insertTestStmt, 1, test.second.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_int64(insertTestStmt, 2, testResultID);
+      sqlite3_bind_text(insertTestStmt, 3, test.second.second.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite_step(database, insertTestStmt);
+    }
+
+    sqlite_exec(database, MergeShardPoints);
+
+    /// Selected up front as well, a mutant already merged from another
+    /// shard is skipped
+    std::vector<ShardMutationResult> mutationResults;
+    selectStmt = sqlite_prepare(database, SelectShardMutationResults);
+    while (sqlite3_step(selectStmt) == SQLITE_ROW) {
+      mutationResults.push_back({ selectExecutionResult(selectStmt),
+                                  sqlite3_column_int64(selectStmt, 10),
+                                  sqlite3_column_int64(selectStmt, 11),
+                                  sqlite3_column_int(selectStmt, 12) });
+    }
+    sqlite3_finalize(selectStmt);
+
+    for (auto &mutationResult : mutationResults) {
+      sqlite3_int64 mutationExecutionResultID =
+        insertExecutionResult(database,
+                              insertExecutionResultStmt,
+                              mutationResult.result);
+
+      sqlite3_bind_int64(insertMutationResultStmt, 1, mutationExecutionResultID);
+      sqlite3_bind_int64(insertMutationResultStmt, 2, mutationResult.testID);
+      sqlite3_bind_int64(insertMutationResultStmt, 3, mutationResult.mutationPointID);
+      sqlite3_bind_int(insertMutationResultStmt, 4, mutationResult.mutationDistance);
+      sqlite_step(database, insertMutationResultStmt);
+    }
+
+    sqlite3_finalize(insertExecutionResultStmt);
+    sqlite3_finalize(insertTestStmt);
+    sqlite3_finalize(insertMutationResultStmt);
+
+    sqlite_exec(database, "COMMIT TRANSACTION;");
+    sqlite_exec(database, "DETACH DATABASE shard;");
+  }
+
+  sqlite3_finalize(attachStmt);
+
+  createIndexes(database);
+
+  sqlite3_close(database);
+
+  outs() << "Results can be found at '" << databasePath << "'\n";
 }
@@ -0,0 +1,62 @@
+#include "ShardPlanner.h"
+
+#include "Config.h"
+#include "ConfigParser.h"
+
+#include "llvm/Support/MD5.h"
+
+using namespace llvm;
+using namespace Mutang;
+
+static uint64_t stableHash(StringRef job) {
+  MD5 hasher;
+  hasher.update(job);
+  MD5::MD5Result hash;
+  hasher.final(hash);
+
+  uint64_t result = 0;
+  for (int i = 0; i < 8; i++) {
+    result = (result << 8) | hash[i];
+  }
+  return result;
+}
+
+ShardPlanner::ShardPlanner(int shardIndex, int shardCount)
+  : shardIndex(shardIndex), shardCount(shardCount)
+{
+  if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+    configurationError("invalid shard " + Twine(shardIndex) + " of " +
+                       Twine(shardCount));
+  }
+
+  loads.resize(shardCount, 0);
+}
+
+ShardPlanner::ShardPlanner(const Config &config)
+  : ShardPlanner(config.getShardIndex(), config.getShardCount())
+{
+}
+
+int ShardPlanner::assign(const std::string &job, uint64_t cost) {
+  if (!isSharded()) {
+    return 0;
+  }
+
+  auto known = assignments.find(job);
+  if (known != assignments.end()) {
+    return known->second;
+  }
+
+  int first = stableHash(job) % shardCount;
+  int shard = first;
+  for (int i = 1; i < shardCount; i++) {
+    int candidate = (first + i) % shardCount;
+    if (loads[candidate] < loads[shard]) {
+      shard = candidate;
+    }
+  }
+
+  loads[shard] += cost;
+  assignments[job] = shard;
+  return shard;
+}
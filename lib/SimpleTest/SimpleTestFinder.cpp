@@ -42,7 +42,8 @@ static bool shouldSkipDefinedFunction(llvm::Function *definedFunction) {
 
 SimpleTestFinder::SimpleTestFinder(
     std::vector<std::unique_ptr<MutationOperator>> mutationOperators)
-    : TestFinder(), mutationOperators(std::move(mutationOperators)) {}
+    : TestFinder(), mutationOperators(std::move(mutationOperators)),
+      scanner(this->mutationOperators) {}
 
 std::vector<std::unique_ptr<Test>> SimpleTestFinder::findTests(Context &Ctx) {
   std::vector<std::unique_ptr<Test>> tests;
@@ -63,20 +64,22 @@ std::vector<std::unique_ptr<Test>> SimpleTestFinder::findTests(Context &Ctx) {
   return tests;
 }
 
-std::vector<std::unique_ptr<Testee>>
+std::vector<Testee *>
 SimpleTestFinder::findTestees(Test *Test, Context &Ctx, int maxDistance) {
   SimpleTest_Test *SimpleTest = dyn_cast<SimpleTest_Test>(Test);
 
   Function *F = SimpleTest->GetTestFunction();
 
-  std::vector<std::unique_ptr<Testee>> testees;
+  TesteeArena &arena = Ctx.getTesteeArena();
+
+  std::vector<Testee *> testees;
   std::queue<Testee *> traversees;
   std::set<Function *> checkedFunctions;
 
   Module *testBodyModule = F->getParent();
 
-  testees.push_back(make_unique<Testee>(F, nullptr, nullptr, 0));
-  traversees.push(testees.back().get());
+  testees.push_back(arena.create(F, nullptr, nullptr, 0));
+  traversees.push(testees.back());
 
   while (!traversees.empty()) {
     Testee *traversee = traversees.front();
@@ -89,7 +92,7 @@ SimpleTestFinder::findTestees(Test *Test, Context &Ctx, int maxDistance) {
     /// as the test itself, then we are not looking for mutation points
     /// in this function assuming it to be a helper function, or the test itself
     if (traverseeFunction->getParent() != testBodyModule) {
-      testees.push_back(std::unique_ptr<Testee>(traversee));
+      testees.push_back(traversee);
     }
 
     /// The function reached the max allowed distance
@@ -171,8 +174,8 @@ SimpleTestFinder::findTestees(Test *Test, Context &Ctx, int maxDistance) {
             /// * Here is a good overview of what's going on:
             /// http://stackoverflow.com/a/6921467/829116
             ///
-            traversees.push(new Testee(definedFunction, callInstruction,
-                                       traversee, mutationDistance + 1));
+            traversees.push(arena.create(definedFunction, callInstruction,
+                                         traversee, mutationDistance + 1));
           }
         }
       }
@@ -185,103 +188,25 @@ SimpleTestFinder::findTestees(Test *Test, Context &Ctx, int maxDistance) {
 std::vector<MutationPoint *>
 SimpleTestFinder::findMutationPoints(const Context &context,
                                      llvm::Function &F) {
-  std::vector<MutationPoint *> MutPoints;
-
-  Module *PM = F.getParent();
-
-  auto FIt = std::find_if(PM->begin(), PM->end(),
-                          [&F](llvm::Function &f) { return &f == &F; });
-
-  assert(FIt != PM->end() && "Expected function to be found in module");
-  int FIndex = std::distance(PM->begin(), FIt);
-
-  for (auto &BB : F) {
-    for (auto &I : BB) {
-
-      for (auto &MutOp : mutationOperators) {
-        if (MutOp->canBeApplied(I)) {
-
-          auto BBIt =
-              std::find_if(F.begin(), F.end(),
-                           [&BB](llvm::BasicBlock &bb) { return &bb == &BB; });
-          auto IIt =
-              std::find_if(BB.begin(), BB.end(),
-                           [&I](llvm::Instruction &i) { return &i == &I; });
-
-          assert(BBIt != F.end() && "Expected block to be found in function");
-
-          int BBIndex = std::distance(F.begin(), BBIt);
-          int IIndex = std::distance(BB.begin(), IIt);
+  if (MutationPointsRegistry.count(&F) != 0) {
+    return MutationPointsRegistry.at(&F);
+  }
 
-          MutationPointAddress Address(FIndex, BBIndex, IIndex);
+  std::vector<MutationPoint *> MutPoints;
 
-          Logger::info() << "Found Mutation point at address: " << FIndex << ' '
-                         << BBIndex << ' ' << IIndex << '\n';
+  NullMutationOperatorFilter filter;
 
-          auto module = context.moduleWithIdentifier(
-              I.getModule()->getModuleIdentifier());
+  for (auto &point : scanner.scan(context, F, filter)) {
+    MutationPointAddress Address = point->getAddress();
+    Logger::info() << "Found Mutation point at address: "
+                   << Address.getFnIndex() << ' ' << Address.getBBIndex()
+                   << ' ' << Address.getIIndex() << '\n';
 
-          MutationPoints.emplace_back(
-              make_unique<MutationPoint>(MutOp.get(), Address, &I, module));
-          MutPoints.push_back(MutationPoints.back().get());
-        }
-      }
-    }
+    MutPoints.push_back(point.get());
+    MutationPoints.emplace_back(std::move(point));
   }
 
   MutationPointsRegistry.insert(std::make_pair(&F, MutPoints));
 
   return MutPoints;
 }
-
-std::vector<std::unique_ptr<MutationPoint>>
-SimpleTestFinder::findMutationPoints(
-    std::vector<MutationOperator *> &MutationOperators, llvm::Function &F) {
-
-  assert(false && "should not reach here");
-  std::vector<std::unique_ptr<MutationPoint>> MutPoints;
-
-  /*
-
-  Module *PM = F.getParent();
-
-  auto FII = std::find_if(PM->begin(), PM->end(),
-                          [&F] (llvm::Function &f) {
-                            return &f == &F;
-                          });
-
-  assert(FII != PM->end() && "Expected function to be found in module");
-  int FIndex = std::distance(PM->begin(), FII);
-
-  for (Function::iterator B = F.begin(), E = F.end(); B != E; ++B) {
-    BasicBlock &BB = *B;
-
-    for (BasicBlock::iterator I = BB.begin(), E = BB.end(); I != E; ++I) {
-      Instruction &Instr = *I;
-
-      for (auto &MutOp : MutationOperators) {
-        if (MutOp->canBeApplied(Instr)) {
-          BasicBlock *BB = Instr.getParent();
-
-          auto BII = std::find_if(F.begin(), F.end(),
-                                  [&BB] (llvm::BasicBlock &bb) {
-                                    return &bb == BB;
-                                  });
-          assert(BII != F.end() && "Expected block to be found in function");
-
-          int BBIndex = std::distance(F.begin(), BII);
-
-          int IIndex = std::distance(B->begin(), I);
-
-          MutationPointAddress Address(FIndex, BBIndex, IIndex);
-
-          MutPoints.emplace_back(make_unique<MutationPoint>(MutOp, Address,
-  &Instr));
-        }
-      }
-    }
-  }
-  */
-
-  return MutPoints;
-}
@@ -9,6 +9,7 @@
 #include "llvm/Support/DynamicLibrary.h"
 
 #include "SimpleTest/SimpleTest_Test.h"
+#include "Toolchain/ProcessSymbolCache.h"
 
 #include <chrono>
 
@@ -29,28 +30,32 @@ extern "C" int mutang_simple_test_printf(const char *fmt, ...) {
 }
 
 class Mutang_SimpleTest_Resolver : public JITSymbolResolver {
+  orc::ObjectLinkingLayer<> &ObjectLayer;
 public:
+  Mutang_SimpleTest_Resolver(orc::ObjectLinkingLayer<> &layer)
+    : ObjectLayer(layer) {}
 
   JITSymbol findSymbol(const std::string &Name) {
     //if (Name == "_printf") {
     //  return findSymbol("mutang_simple_test_printf");
     //}
 
-    if (auto SymAddr = RTDyldMemoryManager::getSymbolAddressInProcess(Name)) {
-      return JITSymbol(SymAddr, JITSymbolFlags::Exported);
-    }
-
-    return JITSymbol(nullptr);
+    return ProcessSymbolCache::shared().findSymbol(Name);
   }
 
   JITSymbol findSymbolInLogicalDylib(const std::string &Name) {
-    return JITSymbol(nullptr);
+    return ObjectLayer.findSymbol(Name, false);
   }
 };
 
 SimpleTestRunner::SimpleTestRunner(TargetMachine &machine)
   : TestRunner(machine) {}
 
+std::unique_ptr<JITSymbolResolver>
+SimpleTestRunner::createResolver(object::ObjectFile *objectFile) {
+  return make_unique<Mutang_SimpleTest_Resolver>(ObjectLayer);
+}
+
 std::string SimpleTestRunner::MangleName(const llvm::StringRef &Name) {
   std::string MangledName;
   {
@@ -72,9 +77,7 @@ ExecutionResult SimpleTestRunner::runTest(Test *Test, ObjectFiles &ObjectFiles)
 
   SimpleTest_Test *SimpleTest = dyn_cast<SimpleTest_Test>(Test);
 
-  auto Handle = ObjectLayer.addObjectSet(ObjectFiles,
-                                         make_unique<SectionMemoryManager>(),
-                                         make_unique<Mutang_SimpleTest_Resolver>());
+  loadProgram(ObjectFiles);
   void *FunctionPointer = TestFunctionPointer(*SimpleTest->GetTestFunction());
 
   auto start = high_resolution_clock::now();
@@ -82,9 +85,7 @@ ExecutionResult SimpleTestRunner::runTest(Test *Test, ObjectFiles &ObjectFiles)
   auto elapsed = high_resolution_clock::now() - start;
 
   ExecutionResult Result;
-  Result.RunningTime = duration_cast<std::chrono::nanoseconds>(elapsed).count();
-
-  ObjectLayer.removeObjectSet(Handle);
+  Result.RunningTime = duration_cast<std::chrono::microseconds>(elapsed).count();
 
   if (result == 1) {
     Result.Status = ExecutionStatus::Passed;
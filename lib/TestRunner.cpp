@@ -1,5 +1,8 @@
 #include "TestRunner.h"
 
+#include "Trace.h"
+#include "Toolchain/ProcessSymbolCache.h"
+
 #include "llvm/ADT/Triple.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/ExecutionEngine/OrcMCJITReplacement.h"
@@ -9,12 +12,112 @@
 #include "llvm/Support/DynamicLibrary.h"
 #include "llvm/Support/TargetSelect.h"
 
+#include <algorithm>
+#include <set>
+
 using namespace Mutang;
 using namespace llvm;
+using namespace llvm::object;
 
 TestRunner::TestRunner(llvm::TargetMachine &targetMachine)
-  : machine(targetMachine)
+  : machine(targetMachine),
+    ObjectLayer(orc::DoNothingOnNotifyLoaded(),
+                [this](ObjectLayerType::ObjSetHandleT handle) {
+                  auto linked = LinkedHandles.find(&*handle);
+                  if (linked != LinkedHandles.end()) {
+                    FinalizedObjects.push_back(linked->second);
+                  }
+                })
 {
   sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
   LLVMLinkInOrcMCJITReplacement();
 }
+
+bool TestRunner::loadProgram(ObjectFiles &objectFiles) {
+  TraceScope scope("link objects", "jit");
+
+  std::set<ObjectFile *> program(objectFiles.begin(), objectFiles.end());
+  std::vector<ObjectFile *> unlinked;
+
+  for (auto &linked : LinkedObjects) {
+    if (program.count(linked.first) == 0) {
+      unlinked.push_back(linked.first);
+    }
+  }
+
+  /// Sets finalized by an earlier run in this process hold its state
+  for (auto objectFile : FinalizedObjects) {
+    if (program.count(objectFile) != 0 && InitialStateObjects.count(objectFile) == 0) {
+      unlinked.push_back(objectFile);
+    }
+  }
+
+  /// Finalized sets may have their relocations bound to the code that
+  /// is being unlinked
+  if (!unlinked.empty()) {
+    for (auto objectFile : InitialStateObjects) {
+      if (program.count(objectFile) != 0) {
+        unlinked.push_back(objectFile);
+      }
+    }
+  }
+
+  bool changed = !unlinked.empty();
+  unloadObjectFiles(unlinked);
+
+  for (auto objectFile : objectFiles) {
+    if (LinkedObjects.count(objectFile) != 0) {
+      continue;
+    }
+
+    changed = true;
+
+    ProcessSymbolCache::shared().prefetch(*objectFile);
+
+    std::vector<ObjectFile *> objectSet({ objectFile });
+    auto handle = ObjectLayer.addObjectSet(std::move(objectSet),
+                                           make_unique<SectionMemoryManager>(),
+                                           createResolver(objectFile));
+    LinkedObjects.insert(std::make_pair(objectFile, handle));
+    LinkedHandles.insert(std::make_pair(&*handle, objectFile));
+  }
+
+  return changed;
+}
+
+void TestRunner::keepFinalizedObjects() {
+  InitialStateObjects.insert(FinalizedObjects.begin(), FinalizedObjects.end());
+}
+
+void TestRunner::unloadObjectFiles(const std::vector<ObjectFile *> &objectFiles) {
+  if (objectFiles.empty()) {
+    return;
+  }
+
+  TraceScope scope("unload objects", "jit");
+
+  /// All the sets are still in place, so the code run by the runner
+  /// (e.g. destructors) may safely refer to any of them
+  willUnloadObjectFiles(objectFiles);
+
+  std::set<ObjectFile *> unloaded;
+  for (auto objectFile : objectFiles) {
+    auto linked = LinkedObjects.find(objectFile);
+    if (linked == LinkedObjects.end()) {
+      continue;
+    }
+
+    LinkedHandles.erase(&*linked->second);
+    ObjectLayer.removeObjectSet(linked->second);
+    LinkedObjects.erase(linked);
+    InitialStateObjects.erase(objectFile);
+    unloaded.insert(objectFile);
+  }
+
+  FinalizedObjects.erase(std::remove_if(FinalizedObjects.begin(),
+                                        FinalizedObjects.end(),
+                                        [&](ObjectFile *objectFile) {
+                                          return unloaded.count(objectFile) != 0;
+                                        }),
+                         FinalizedObjects.end());
+}
@@ -0,0 +1,63 @@
+#include "TimeoutPolicy.h"
+
+#include "Config.h"
+#include "ConfigParser.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace llvm;
+using namespace Mutang;
+
+TimeoutPolicy::TimeoutPolicy(double multiplier,
+                             long long minimumTimeoutMilliseconds,
+                             long long maximumTimeoutMilliseconds)
+  : multiplier(multiplier),
+    minimumTimeout(minimumTimeoutMilliseconds),
+    maximumTimeout(maximumTimeoutMilliseconds)
+{
+  if (minimumTimeout > maximumTimeout) {
+    configurationError("min_timeout " + Twine(minimumTimeout) +
+                       " is greater than max_timeout " + Twine(maximumTimeout));
+  }
+}
+
+TimeoutPolicy::TimeoutPolicy(const Config &config)
+  : TimeoutPolicy(config.getTimeoutMultiplier(),
+                  config.getMinimumTimeout(),
+                  config.getMaximumTimeout())
+{
+}
+
+long long TimeoutPolicy::timeoutFor(const std::vector<long long> &runningTimes) const {
+  if (runningTimes.empty()) {
+    return maximumTimeout;
+  }
+
+  std::vector<long long> samples(runningTimes);
+  std::sort(samples.begin(), samples.end());
+
+  const size_t middle = samples.size() / 2;
+  double median = samples[middle];
+  if (samples.size() % 2 == 0) {
+    median = (samples[middle - 1] + samples[middle]) / 2.0;
+  }
+
+  double mean = 0;
+  for (auto sample : samples) {
+    mean += sample;
+  }
+  mean /= samples.size();
+
+  double variance = 0;
+  for (auto sample : samples) {
+    variance += (sample - mean) * (sample - mean);
+  }
+  variance /= samples.size();
+
+  const double expectedMicroseconds = median + 2 * std::sqrt(variance);
+  const double timeout = std::ceil(expectedMicroseconds * multiplier / 1000.0);
+
+  return std::min(maximumTimeout,
+                  std::max(minimumTimeout, static_cast<long long>(timeout)));
+}
@@ -0,0 +1,106 @@
+#include "Toolchain/MachineCodeHash.h"
+
+#include "llvm/Object/ELFObjectFile.h"
+#include "llvm/Object/SymbolSize.h"
+#include "llvm/Support/MD5.h"
+
+using namespace llvm;
+using namespace llvm::object;
+
+std::string Mutang::hashFunctionCode(const ObjectFile &object,
+                                     StringRef functionName) {
+  /// Mach-O symbols carry the global prefix
+  std::string symbolName = (object.isMachO() ? "_" : "") + functionName.str();
+
+  for (auto &symbolAndSize : computeSymbolSizes(object)) {
+    const SymbolRef &symbol = symbolAndSize.first;
+
+    Expected<StringRef> name = symbol.getName();
+    if (!name) {
+      consumeError(name.takeError());
+      continue;
+    }
+    if (name.get() != symbolName) {
+      continue;
+    }
+
+    Expected<section_iterator> sectionOrError = symbol.getSection();
+    Expected<uint64_t> addressOrError = symbol.getAddress();
+    if (!sectionOrError || !addressOrError ||
+        sectionOrError.get() == object.section_end()) {
+      if (!sectionOrError) {
+        consumeError(sectionOrError.takeError());
+      }
+      if (!addressOrError) {
+        consumeError(addressOrError.takeError());
+      }
+      return "";
+    }
+
+    const SectionRef &section = *sectionOrError.get();
+    StringRef contents;
+    if (section.getContents(contents)) {
+      return "";
+    }
+
+    const uint64_t begin = addressOrError.get() - section.getAddress();
+    const uint64_t end = begin + symbolAndSize.second;
+    if (end > contents.size()) {
+      return "";
+    }
+
+    MD5 hasher;
+    hasher.update(contents.slice(begin, end));
+
+    /// ELF keeps relocations in sections of their own, Mach-O in the
+    /// relocated section itself
+    for (auto &relocations : object.sections()) {
+      section_iterator relocated = relocations.getRelocatedSection();
+      bool relocatesFunction = relocated == object.section_end()
+                               ? relocations == section
+                               : *relocated == section;
+      if (!relocatesFunction) {
+        continue;
+      }
+
+      for (auto &relocation : relocations.relocations()) {
+        uint64_t offset = relocation.getOffset();
+        if (offset < begin || end <= offset) {
+          continue;
+        }
+
+        hasher.update(std::to_string(offset - begin));
+        hasher.update(std::to_string(relocation.getType()));
+
+        /// RELA relocations keep the addend out of the code, e.g. the
+        /// offset into a constant pool or a string
+        if (isa<ELFObjectFileBase>(&object)) {
+          Expected<int64_t> addend = ELFRelocationRef(relocation).getAddend();
+          if (addend) {
+            hasher.update(std::to_string(addend.get()));
+          } else {
+            consumeError(addend.takeError());
+          }
+        }
+
+        symbol_iterator target = relocation.getSymbol();
+        if (target != object.symbol_end()) {
+          Expected<StringRef> targetName = target->getName();
+          if (targetName) {
+            hasher.update(targetName.get());
+          } else {
+            consumeError(targetName.takeError());
+          }
+        }
+      }
+    }
+
+    MD5::MD5Result hash;
+    hasher.final(hash);
+    SmallString<32> result;
+    MD5::stringifyResult(hash, result);
+    return result.str();
+  }
+
+  return "";
+}
@@ -6,6 +6,7 @@
 
 #include <dirent.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 using namespace Mutang;
 using namespace llvm;
@@ -111,12 +112,21 @@ void ObjectCache::putObjectOnDisk(
     return;
   }
 
+  /// Workers share the cache directory: the object is written under a name
+  /// of its own and renamed, so no one ever reads it half written
   std::string cacheName(cacheDirectory + "/" + identifier + ".o");
+  std::string temporaryName(cacheName + "." + std::to_string(getpid()) + ".tmp");
   std::error_code EC;
-  raw_fd_ostream outfile(cacheName, EC, sys::fs::F_None);
+  raw_fd_ostream outfile(temporaryName, EC, sys::fs::F_None);
   outfile.write(object.getBinary()->getMemoryBufferRef().getBufferStart(),
                 object.getBinary()->getMemoryBufferRef().getBufferSize());
   outfile.close();
+
+  if (EC || outfile.has_error() ||
+      sys::fs::rename(temporaryName, cacheName)) {
+    outfile.clear_error();
+    sys::fs::remove(temporaryName);
+  }
 }
 
 void ObjectCache::putObject(OwningBinary<ObjectFile> object,
@@ -0,0 +1,80 @@
+#include "Toolchain/ProcessSymbolCache.h"
+
+#include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
+
+#include <sys/mman.h>
+
+using namespace Mutang;
+using namespace llvm;
+using namespace llvm::object;
+
+ProcessSymbolCache::ProcessSymbolCache() {
+  void *sharedMemory = mmap(NULL,
+                            sizeof(Counters),
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS,
+                            -1,
+                            0);
+  assert(sharedMemory != MAP_FAILED && "Can't map memory for the counters");
+
+  counters = new (sharedMemory) Counters();
+  resetCounters();
+}
+
+ProcessSymbolCache &ProcessSymbolCache::shared() {
+  static ProcessSymbolCache cache;
+  return cache;
+}
+
+JITSymbol ProcessSymbolCache::findSymbol(const std::string &name) {
+  auto cached = addresses.find(name);
+  if (cached != addresses.end()) {
+    counters->hits++;
+    if (cached->second) {
+      return JITSymbol(cached->second, JITSymbolFlags::Exported);
+    }
+    return JITSymbol(nullptr);
+  }
+
+  counters->misses++;
+  uint64_t address = RTDyldMemoryManager::getSymbolAddressInProcess(name);
+  addresses[name] = address;
+
+  if (address) {
+    return JITSymbol(address, JITSymbolFlags::Exported);
+  }
+  return JITSymbol(nullptr);
+}
+
+void ProcessSymbolCache::prefetch(const ObjectFile &objectFile) {
+  for (auto &symbol : objectFile.symbols()) {
+    if ((symbol.getFlags() & SymbolRef::SF_Undefined) == 0) {
+      continue;
+    }
+
+    Expected<StringRef> name = symbol.getName();
+    if (!name) {
+      consumeError(name.takeError());
+      continue;
+    }
+
+    if (name->empty() || addresses.count(*name)) {
+      continue;
+    }
+
+    findSymbol(name->str());
+  }
+}
+
+uint64_t ProcessSymbolCache::getHits() const {
+  return counters->hits;
+}
+
+uint64_t ProcessSymbolCache::getMisses() const {
+  return counters->misses;
+}
+
+void ProcessSymbolCache::resetCounters() {
+  counters->hits = 0;
+  counters->misses = 0;
+}
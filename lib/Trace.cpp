@@ -0,0 +1,202 @@
+#include "Trace.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+using namespace std::chrono;
+
+static void writeJSONString(raw_ostream &out, const std::string &string) {
+  out << '"';
+  for (char c : string) {
+    switch (c) {
+      case '"':  out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << format("\\u%04x", c);
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+Trace::Trace() : enabled(false), ownerPID(getpid()), origin(steady_clock::now()) {
+  void *sharedMemory = mmap(NULL,
+                            sizeof(SharedPhases),
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS,
+                            -1,
+                            0);
+  assert(sharedMemory != MAP_FAILED && "Can't map memory for the trace");
+
+  sharedPhases = new (sharedMemory) SharedPhases();
+  sharedPhases->size = 0;
+}
+
+Trace &Trace::shared() {
+  static Trace trace;
+  return trace;
+}
+
+void Trace::setEnabled(bool enabled) {
+  this->enabled = enabled;
+  ownerPID = getpid();
+  origin = steady_clock::now();
+  spans.clear();
+  sharedPhases->size = 0;
+}
+
+long long Trace::now() const {
+  return duration_cast<microseconds>(steady_clock::now() - origin).count();
+}
+
+void Trace::addSpan(const std::string &name,
+                    const std::string &category,
+                    long long start,
+                    long long duration,
+                    const std::string &detail) {
+  if (!enabled) {
+    return;
+  }
+
+  if (getpid() != ownerPID) {
+    addSharedSpan(name, duration);
+    return;
+  }
+
+  spans.push_back({ name, category, detail, start, duration });
+}
+
+/// Two children may claim a slot for the same name, the summary merges them.
+/// Once the slots run out the spans are dropped
+void Trace::addSharedSpan(const std::string &name, long long duration) {
+  const int size = std::min<int>(sharedPhases->size, 32);
+  for (int i = 0; i < size; i++) {
+    SharedPhase &phase = sharedPhases->phases[i];
+    if (phase.ready && name == phase.name) {
+      phase.count++;
+      phase.total += duration;
+      return;
+    }
+  }
+
+  const int index = sharedPhases->size++;
+  if (index >= 32) {
+    return;
+  }
+
+  SharedPhase &phase = sharedPhases->phases[index];
+  strncpy(phase.name, name.c_str(), sizeof(phase.name) - 1);
+  phase.name[sizeof(phase.name) - 1] = '\0';
+  phase.count = 1;
+  phase.total = duration;
+  phase.ready = true;
+}
+
+bool Trace::writeChromeTrace(const std::string &path) const {
+  std::error_code EC;
+  raw_fd_ostream out(path, EC, sys::fs::F_Text);
+  if (EC) {
+    return false;
+  }
+
+  out << "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < spans.size(); i++) {
+    const Span &span = spans[i];
+    out << "{\"name\":";
+    writeJSONString(out, span.name);
+    out << ",\"cat\":";
+    writeJSONString(out, span.category);
+    out << ",\"ph\":\"X\",\"ts\":" << span.start
+        << ",\"dur\":" << span.duration
+        << ",\"pid\":" << ownerPID << ",\"tid\":0";
+    if (!span.detail.empty()) {
+      out << ",\"args\":{\"detail\":";
+      writeJSONString(out, span.detail);
+      out << "}";
+    }
+    out << (i + 1 == spans.size() ? "}\n" : "},\n");
+  }
+  out << "],\"displayTimeUnit\":\"ms\"}\n";
+
+  out.close();
+  if (out.has_error()) {
+    out.clear_error();
+    return false;
+  }
+  return true;
+}
+
+void Trace::printSummary(raw_ostream &out) const {
+  /// Count and total duration per phase
+  std::map<std::string, std::pair<uint64_t, long long>> phases;
+  for (auto &span : spans) {
+    auto &phase = phases[span.name];
+    phase.first++;
+    phase.second += span.duration;
+  }
+
+  const int size = std::min<int>(sharedPhases->size, 32);
+  for (int i = 0; i < size; i++) {
+    const SharedPhase &phase = sharedPhases->phases[i];
+    if (!phase.ready) {
+      continue;
+    }
+    auto &summary = phases[std::string(phase.name) + " (forked)"];
+    summary.first += phase.count;
+    summary.second += phase.total;
+  }
+
+  std::vector<std::pair<std::string, std::pair<uint64_t, long long>>>
+    sorted(phases.begin(), phases.end());
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const std::pair<std::string, std::pair<uint64_t, long long>> &a,
+                      const std::pair<std::string, std::pair<uint64_t, long long>> &b) {
+                     return a.second.second > b.second.second;
+                   });
+
+  out << left_justify("Phase", 32) << right_justify("Count", 11)
+      << right_justify("Total (ms)", 15) << right_justify("Mean (ms)", 15) << "\n";
+  for (auto &phase : sorted) {
+    const uint64_t count = phase.second.first;
+    const double total = phase.second.second / 1000.0;
+    out << format("%-32s %10llu %14.3f %14.3f\n",
+                  phase.first.c_str(),
+                  (unsigned long long)count,
+                  total,
+                  count ? total / count : 0.0);
+  }
+}
+
+TraceScope::TraceScope(const char *name,
+                       const char *category,
+                       const std::string &detail)
+  : name(name), category(category), start(-1)
+{
+  Trace &trace = Trace::shared();
+  if (trace.isEnabled()) {
+    this->detail = detail;
+    start = trace.now();
+  }
+}
+
+TraceScope::~TraceScope() {
+  if (start == -1) {
+    return;
+  }
+
+  Trace &trace = Trace::shared();
+  trace.addSpan(name, category, start, trace.now() - start, detail);
+}
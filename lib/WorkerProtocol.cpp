@@ -0,0 +1,263 @@
+#include "WorkerProtocol.h"
+
+#include "Logger.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+/// A worker going away must not take the coordinator down with SIGPIPE
+static bool writeAll(int fd, const char *buffer, size_t size) {
+  while (size > 0) {
+    ssize_t count = ::send(fd, buffer, size, MSG_NOSIGNAL);
+    if (count == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    buffer += count;
+    size -= count;
+  }
+  return true;
+}
+
+static bool readAll(int fd, char *buffer, size_t size) {
+  while (size > 0) {
+    ssize_t count = read(fd, buffer, size);
+    if (count == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (count == 0) {
+      return false;
+    }
+    buffer += count;
+    size -= count;
+  }
+  return true;
+}
+
+/// Lengths are in network byte order: with ssh forwarding the worker
+/// may run on another machine
+static bool writeLength(int fd, uint32_t length) {
+  uint32_t encoded = htonl(length);
+  return writeAll(fd, reinterpret_cast<const char *>(&encoded), sizeof(encoded));
+}
+
+static bool readLength(int fd, uint32_t &length) {
+  uint32_t encoded = 0;
+  if (!readAll(fd, reinterpret_cast<char *>(&encoded), sizeof(encoded))) {
+    return false;
+  }
+  length = ntohl(encoded);
+  return true;
+}
+
+/// Numbers go as decimal text, a field that is not one makes the whole
+/// message malformed
+template <typename T>
+static bool parseNumber(const std::string &field, T &value) {
+  return !StringRef(field).getAsInteger(10, value);
+}
+
+static bool sockaddrFor(const std::string &socketPath, sockaddr_un &address) {
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    Logger::error() << "Socket path is too long: " << socketPath << "\n";
+    return false;
+  }
+  strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+  return true;
+}
+
+const uint32_t WorkerChannel::MaxFields;
+const uint32_t WorkerChannel::MaxFieldLength;
+
+WorkerChannel::WorkerChannel(int fileDescriptor)
+  : fileDescriptor(fileDescriptor)
+{
+}
+
+WorkerChannel::~WorkerChannel() {
+  if (fileDescriptor != -1) {
+    close(fileDescriptor);
+  }
+}
+
+bool WorkerChannel::send(const std::vector<std::string> &fields) {
+  if (fields.size() > MaxFields) {
+    return false;
+  }
+  for (auto &field : fields) {
+    if (field.size() > MaxFieldLength) {
+      return false;
+    }
+  }
+
+  if (!writeLength(fileDescriptor, fields.size())) {
+    return false;
+  }
+  for (auto &field : fields) {
+    if (!writeLength(fileDescriptor, field.size()) ||
+        !writeAll(fileDescriptor, field.data(), field.size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WorkerChannel::receive(std::vector<std::string> &fields) {
+  fields.clear();
+
+  uint32_t count = 0;
+  if (!readLength(fileDescriptor, count) || count > MaxFields) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t length = 0;
+    if (!readLength(fileDescriptor, length) || length > MaxFieldLength) {
+      return false;
+    }
+    std::string field(length, '\0');
+    if (length != 0 && !readAll(fileDescriptor, &field[0], length)) {
+      return false;
+    }
+    fields.push_back(std::move(field));
+  }
+  return true;
+}
+
+bool WorkerChannel::sendJob(const WorkerJob &job) {
+  return send({ WorkerMessage::Job,
+                std::to_string(job.id),
+                job.testName,
+                job.mutationPoint,
+                std::to_string(job.timeout),
+                std::to_string(job.iterationBudget) });
+}
+
+bool WorkerChannel::sendResult(uint64_t jobId, const ExecutionResult &result) {
+  return send({ WorkerMessage::Result,
+                std::to_string(jobId),
+                std::to_string(result.Status),
+                std::to_string(result.RunningTime),
+                result.stdoutOutput.substr(0, MaxFieldLength),
+                result.stderrOutput.substr(0, MaxFieldLength),
+                std::to_string(result.Usage.UserTime),
+                std::to_string(result.Usage.SystemTime),
+                std::to_string(result.Usage.MaxRSS),
+                std::to_string(result.Usage.MajorFaults),
+                std::to_string(result.Usage.MinorFaults),
+                std::to_string(result.Usage.ContextSwitches) });
+}
+
+bool WorkerChannel::decodeJob(const std::vector<std::string> &fields,
+                              WorkerJob &job) {
+  if (fields.size() != 6 || fields[0] != WorkerMessage::Job) {
+    return false;
+  }
+  job.testName = fields[2];
+  job.mutationPoint = fields[3];
+  return parseNumber(fields[1], job.id) &&
+         parseNumber(fields[4], job.timeout) &&
+         parseNumber(fields[5], job.iterationBudget);
+}
+
+bool WorkerChannel::decodeResult(const std::vector<std::string> &fields,
+                                 uint64_t &jobId,
+                                 ExecutionResult &result) {
+  if (fields.size() != 12 || fields[0] != WorkerMessage::Result) {
+    return false;
+  }
+
+  int status = 0;
+  if (!parseNumber(fields[1], jobId) ||
+      !parseNumber(fields[2], status) ||
+      !parseNumber(fields[3], result.RunningTime) ||
+      !parseNumber(fields[6], result.Usage.UserTime) ||
+      !parseNumber(fields[7], result.Usage.SystemTime) ||
+      !parseNumber(fields[8], result.Usage.MaxRSS) ||
+      !parseNumber(fields[9], result.Usage.MajorFaults) ||
+      !parseNumber(fields[10], result.Usage.MinorFaults) ||
+      !parseNumber(fields[11], result.Usage.ContextSwitches)) {
+    return false;
+  }
+  if (status < Invalid || status > ResourceLimitExceeded) {
+    return false;
+  }
+
+  result.Status = static_cast<ExecutionStatus>(status);
+  result.stdoutOutput = fields[4];
+  result.stderrOutput = fields[5];
+  return true;
+}
+
+int WorkerChannel::listenOn(const std::string &socketPath, int backlog) {
+  sockaddr_un address;
+  if (!sockaddrFor(socketPath, address)) {
+    return -1;
+  }
+
+  /// A socket left over by a previous run would make bind fail, anything
+  /// else at the path is not ours to remove
+  struct stat status;
+  if (lstat(socketPath.c_str(), &status) == 0) {
+    if (!S_ISSOCK(status.st_mode)) {
+      Logger::error() << "Cannot listen on " << socketPath
+                      << ": the path exists and is not a socket\n";
+      return -1;
+    }
+    unlink(socketPath.c_str());
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) {
+    Logger::error() << "Cannot create socket: " << strerror(errno) << "\n";
+    return -1;
+  }
+
+  if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1 ||
+      listen(fd, backlog) == -1) {
+    Logger::error() << "Cannot listen on " << socketPath << ": "
+                    << strerror(errno) << "\n";
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+int WorkerChannel::connectTo(const std::string &socketPath) {
+  sockaddr_un address;
+  if (!sockaddrFor(socketPath, address)) {
+    return -1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) {
+    Logger::error() << "Cannot create socket: " << strerror(errno) << "\n";
+    return -1;
+  }
+
+  if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == -1) {
+    Logger::error() << "Cannot connect to " << socketPath << ": "
+                    << strerror(errno) << "\n";
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
@@ -5,8 +5,10 @@
 #include "Logger.h"
 #include "ModuleLoader.h"
 #include "MutationPoint.h"
+#include "MutationOperators/MutationOperatorRegistry.h"
 #include "SQLiteReporter.h"
 #include "Result.h"
+#include "Trace.h"
 
 #include "Toolchain/Toolchain.h"
 
@@ -60,6 +62,14 @@ static cl::opt<bool> PrintMutationPoints(
     llvm::cl::cat(MullOptionCategory)
 );
 
+static cl::opt<std::string> WorkerSocket(
+    "worker",
+    llvm::cl::desc("Run mutants for the coordinator listening on the socket."),
+    llvm::cl::value_desc("socket path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(MullOptionCategory)
+);
+
 static cl::opt<std::string> ConfigFile(
     llvm::cl::desc("<config file>"),
     llvm::cl::Positional
@@ -74,7 +84,8 @@ int debug_main() {
   LLVMContext Ctx;
   ModuleLoader Loader(Ctx);
 
-  GoogleTestFinder TestFinder;
+  MutationOperatorRegistry registry;
+  GoogleTestFinder TestFinder(registry.createOperators(config.getMutationOperators()));
   Toolchain toolchain(config);
   GoogleTestRunner Runner(toolchain.targetMachine());
 
@@ -103,6 +114,9 @@ int main(int argc, char *argv[]) {
   ConfigParser Parser;
   auto config = Parser.loadConfig(ConfigFile.c_str());
 
+  Trace &trace = Trace::shared();
+  trace.setEnabled(!config.getTraceFile().empty());
+
   InitializeNativeTarget();
   InitializeNativeTargetAsmPrinter();
   InitializeNativeTargetAsmParser();
@@ -111,19 +125,36 @@ int main(int argc, char *argv[]) {
   ModuleLoader Loader(Ctx);
   Toolchain toolchain(config);
 
+  MutationOperatorRegistry registry;
+  auto mutationOperators = registry.createOperators(config.getMutationOperators());
+
 #if 1
-  GoogleTestFinder TestFinder;
+  GoogleTestFinder TestFinder(std::move(mutationOperators));
   GoogleTestRunner Runner(toolchain.targetMachine());
 #else
-  SimpleTestFinder TestFinder;
+  SimpleTestFinder TestFinder(std::move(mutationOperators));
   SimpleTestRunner Runner(toolchain.targetMachine());
 #endif
 
   Driver driver(config, Loader, TestFinder, Runner, toolchain);
+
+  /// A worker reports its results to the coordinator, not to a database
+  if (!WorkerSocket.empty()) {
+    driver.RunWorker(WorkerSocket);
+    return EXIT_SUCCESS;
+  }
+
   auto result = driver.Run();
 
-  SQLiteReporter reporter;
+  SQLiteReporter reporter(config);
   reporter.reportResults(result);
+
+  if (trace.isEnabled()) {
+    trace.printSummary(Logger::info());
+    if (!trace.writeChromeTrace(config.getTraceFile())) {
+      Logger::error() << "Cannot write trace to " << config.getTraceFile() << "\n";
+    }
+  }
   /// It does crash at the very moment
   /// llvm_shutdown();
   return EXIT_SUCCESS;
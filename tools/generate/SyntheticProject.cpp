@@ -0,0 +1,291 @@
+#include "SyntheticProject.h"
+
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cassert>
+
+using namespace Mutang;
+using namespace llvm;
+
+/// Constants of the k-th group of mutation sites of a function, chosen so
+/// that the conditions go both ways across the project
+static uint32_t addend(int module, int level, int index, int k) {
+  return 1 + (module * 7919 + level * 104729 + index * 131 + k * 17) % 1000;
+}
+
+static int32_t threshold(int module, int level, int index, int k) {
+  return (module * 31 + level * 17 + index * 7 + k * 3) % 2000 - 1000;
+}
+
+static uint32_t mask(int k) {
+  return 0x5bd1e995u + k;
+}
+
+static int32_t testSeed(int module, int index) {
+  return 1 + module * 100 + index;
+}
+
+SyntheticProject::SyntheticProject(const SyntheticProjectOptions &options)
+  : options(options)
+{
+  assert(options.modules > 0 && options.depth > 0 && options.fanOut > 0 &&
+         options.operatorDensity >= 0 && "Invalid synthetic project shape");
+}
+
+std::string SyntheticProject::functionName(int module, int level, int index) const {
+  return "synthetic_" + std::to_string(module) + "_" + std::to_string(level) +
+         "_" + std::to_string(index);
+}
+
+/// Callees of a function as (module, index) pairs on the next level
+std::vector<std::pair<int, int>>
+SyntheticProject::callees(int module, int level, int index) const {
+  std::vector<std::pair<int, int>> result;
+  if (level + 1 == options.depth) {
+    return result;
+  }
+
+  for (int k = 0; k < options.fanOut; k++) {
+    result.push_back(std::make_pair((module + k) % options.modules,
+                                    (index + k) % options.fanOut));
+  }
+  return result;
+}
+
+/// The reference implementation the tests compare against, all the
+/// arithmetic wraps around just like the generated code
+int32_t SyntheticProject::evaluate(int module, int level, int index, int32_t x) const {
+  uint32_t acc = x;
+  for (int k = 0; k < options.operatorDensity; k++) {
+    acc += addend(module, level, index, k);
+    if (!(static_cast<int32_t>(acc) > threshold(module, level, index, k))) {
+      acc ^= mask(k);
+    }
+  }
+
+  for (auto &callee : callees(module, level, index)) {
+    acc ^= evaluate(callee.first, level + 1, callee.second, acc);
+  }
+
+  return acc;
+}
+
+uint64_t SyntheticProject::mutationPointCount() const {
+  return uint64_t(options.modules) * options.depth * options.fanOut *
+         options.operatorDensity * 3;
+}
+
+std::unique_ptr<Module>
+SyntheticProject::createTesteeModule(int module, LLVMContext &context) const {
+  auto testee = make_unique<Module>("synthetic_testee_" + std::to_string(module),
+                                    context);
+
+  Type *int32Type = Type::getInt32Ty(context);
+  FunctionType *functionType = FunctionType::get(int32Type, { int32Type }, false);
+  FunctionType *sinkType = FunctionType::get(Type::getVoidTy(context),
+                                             { int32Type }, false);
+
+  Function *sink = Function::Create(sinkType, GlobalValue::ExternalLinkage,
+                                    "synthetic_sink", testee.get());
+
+  /// The sink does not change results, removing a call to it is a mutant
+  /// that survives
+  if (module == 0) {
+    auto total = new GlobalVariable(*testee, int32Type, false,
+                                    GlobalValue::ExternalLinkage,
+                                    ConstantInt::get(int32Type, 0),
+                                    "synthetic_sink_total");
+
+    IRBuilder<> builder(BasicBlock::Create(context, "entry", sink));
+    Value *value = builder.CreateLoad(total, "total");
+    builder.CreateStore(builder.CreateXor(value, &*sink->arg_begin()), total);
+    builder.CreateRetVoid();
+  }
+
+  auto getFunction = [&](int module, int level, int index) {
+    return cast<Function>(testee->getOrInsertFunction(functionName(module, level, index),
+                                                      functionType));
+  };
+
+  for (int level = 0; level < options.depth; level++) {
+    for (int index = 0; index < options.fanOut; index++) {
+      Function *function = getFunction(module, level, index);
+      IRBuilder<> builder(BasicBlock::Create(context, "entry", function));
+
+      Value *acc = &*function->arg_begin();
+      for (int k = 0; k < options.operatorDensity; k++) {
+        acc = builder.CreateAdd(acc,
+                                ConstantInt::get(int32Type, addend(module, level, index, k)),
+                                "add");
+        Value *condition =
+          builder.CreateICmpSGT(acc,
+                                ConstantInt::get(int32Type, threshold(module, level, index, k),
+                                                 true),
+                                "cmp");
+        Value *masked = builder.CreateXor(acc, ConstantInt::get(int32Type, mask(k)), "masked");
+        acc = builder.CreateSelect(condition, acc, masked, "select");
+        builder.CreateCall(sink, { acc });
+      }
+
+      for (auto &callee : callees(module, level, index)) {
+        Function *calleeFunction = getFunction(callee.first, level + 1, callee.second);
+        Value *result = builder.CreateCall(calleeFunction, { acc }, "call");
+        acc = builder.CreateXor(acc, result, "acc");
+      }
+
+      builder.CreateRet(acc);
+    }
+  }
+
+  return testee;
+}
+
+std::unique_ptr<Module>
+SyntheticProject::createTesterModule(int module, LLVMContext &context) const {
+  auto tester = make_unique<Module>("synthetic_tester_" + std::to_string(module),
+                                    context);
+
+  Type *int32Type = Type::getInt32Ty(context);
+  FunctionType *functionType = FunctionType::get(int32Type, { int32Type }, false);
+  FunctionType *testType = FunctionType::get(int32Type, false);
+
+  for (int index = 0; index < options.fanOut; index++) {
+    Function *test = Function::Create(testType, GlobalValue::ExternalLinkage,
+                                      "test_synthetic_" + std::to_string(module) +
+                                      "_" + std::to_string(index),
+                                      tester.get());
+    Function *testee =
+      cast<Function>(tester->getOrInsertFunction(functionName(module, 0, index),
+                                                 functionType));
+
+    const int32_t seed = testSeed(module, index);
+    IRBuilder<> builder(BasicBlock::Create(context, "entry", test));
+    Value *result = builder.CreateCall(testee,
+                                       { ConstantInt::get(int32Type, seed, true) },
+                                       "result");
+    Value *expected = ConstantInt::get(int32Type, evaluate(module, 0, index, seed), true);
+    Value *passed = builder.CreateICmpEQ(result, expected, "passed");
+    builder.CreateRet(builder.CreateZExt(passed, int32Type));
+  }
+
+  return tester;
+}
+
+std::vector<std::unique_ptr<Module>>
+SyntheticProject::createSimpleTestModules(LLVMContext &context) const {
+  std::vector<std::unique_ptr<Module>> modules;
+  for (int module = 0; module < options.modules; module++) {
+    modules.push_back(createTesteeModule(module, context));
+  }
+  for (int module = 0; module < options.modules; module++) {
+    modules.push_back(createTesterModule(module, context));
+  }
+  return modules;
+}
+
+std::string SyntheticProject::createTesteeSource(int module) const {
+  std::string source;
+  raw_string_ostream out(source);
+
+  out << "#include \"synthetic.h\"\n\n";
+
+  if (module == 0) {
+    out << "unsigned synthetic_sink_total = 0;\n\n"
+        << "void synthetic_sink(unsigned value) {\n"
+        << "  synthetic_sink_total ^= value;\n"
+        << "}\n\n";
+  }
+
+  for (int level = 0; level < options.depth; level++) {
+    for (int index = 0; index < options.fanOut; index++) {
+      out << "int " << functionName(module, level, index) << "(int x) {\n"
+          << "  unsigned acc = x;\n";
+      for (int k = 0; k < options.operatorDensity; k++) {
+        out << "  acc += " << addend(module, level, index, k) << "u;\n"
+            << "  acc = (int)acc > " << threshold(module, level, index, k)
+            << " ? acc : acc ^ " << format_hex(mask(k), 10) << "u;\n"
+            << "  synthetic_sink(acc);\n";
+      }
+      for (auto &callee : callees(module, level, index)) {
+        out << "  acc ^= " << functionName(callee.first, level + 1, callee.second)
+            << "(acc);\n";
+      }
+      out << "  return acc;\n"
+          << "}\n\n";
+    }
+  }
+
+  return out.str();
+}
+
+std::string SyntheticProject::createTestSource(int module) const {
+  std::string source;
+  raw_string_ostream out(source);
+
+  out << "#include \"synthetic.h\"\n\n"
+      << "#include \"gtest/gtest.h\"\n\n";
+
+  for (int index = 0; index < options.fanOut; index++) {
+    const int32_t seed = testSeed(module, index);
+    const uint32_t expected = evaluate(module, 0, index, seed);
+    out << "TEST(Synthetic_" << module << ", Function_" << index << ") {\n"
+        << "  ASSERT_EQ(" << format_hex(expected, 10) << "u, (unsigned)"
+        << functionName(module, 0, index) << "(" << seed << "));\n"
+        << "}\n\n";
+  }
+
+  return out.str();
+}
+
+std::vector<std::pair<std::string, std::string>>
+SyntheticProject::createGoogleTestSources() const {
+  std::vector<std::pair<std::string, std::string>> sources;
+
+  std::string header;
+  raw_string_ostream headerStream(header);
+  headerStream << "#pragma once\n\n"
+               << "void synthetic_sink(unsigned value);\n\n";
+  for (int module = 0; module < options.modules; module++) {
+    for (int level = 0; level < options.depth; level++) {
+      for (int index = 0; index < options.fanOut; index++) {
+        headerStream << "int " << functionName(module, level, index) << "(int x);\n";
+      }
+    }
+  }
+  sources.push_back(std::make_pair("synthetic.h", headerStream.str()));
+
+  std::string bitcode;
+  for (int module = 0; module < options.modules; module++) {
+    const std::string testee = "testee_" + std::to_string(module);
+    const std::string test = "test_" + std::to_string(module);
+    sources.push_back(std::make_pair(testee + ".cpp", createTesteeSource(module)));
+    sources.push_back(std::make_pair(test + ".cpp", createTestSource(module)));
+    bitcode += " " + testee + ".bc " + test + ".bc";
+  }
+
+  /// No optimizations, otherwise the conditions are folded into selects
+  /// and the calls to the sink may be inlined
+  std::string makefile;
+  raw_string_ostream makefileStream(makefile);
+  makefileStream
+    << "# make GTEST_DIR=/path/to/googletest/googletest\n"
+    << "CXX = clang++\n"
+    << "CXXFLAGS = -std=c++11 -O0 -g -emit-llvm -c -I$(GTEST_DIR)/include -I$(GTEST_DIR)\n\n"
+    << "BITCODE =" << bitcode << " gtest-all.bc\n\n"
+    << "all: $(BITCODE)\n\n"
+    << "%.bc: %.cpp synthetic.h\n"
+    << "\t$(CXX) $(CXXFLAGS) $< -o $@\n\n"
+    << "gtest-all.bc: $(GTEST_DIR)/src/gtest-all.cc\n"
+    << "\t$(CXX) $(CXXFLAGS) $< -o $@\n\n"
+    << "clean:\n"
+    << "\trm -f $(BITCODE)\n";
+  sources.push_back(std::make_pair("Makefile", makefileStream.str()));
+
+  return sources;
+}
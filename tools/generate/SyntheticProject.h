@@ -0,0 +1,74 @@
+#pragma once
+
+#include "llvm/IR/Module.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+  class LLVMContext;
+}
+
+namespace Mutang {
+
+  struct SyntheticProjectOptions {
+    /// Number of testee modules, each one comes with its own tester module
+    int modules;
+    /// Levels of the call graph below the functions called by the tests
+    int depth;
+    /// Functions per level of a module, and calls made by each function
+    /// to the next level
+    int fanOut;
+    /// Mutation sites per function for each of the add, negate condition
+    /// and remove void function operators
+    int operatorDensity;
+  };
+
+  /// A project of predictable shape for measuring how Mutang scales.
+  ///
+  /// Every testee module has `depth` levels of `fanOut` functions:
+  ///
+  ///   synthetic_<module>_<level>_<index>(int x)
+  ///
+  /// A function calls `fanOut` functions of the next level, spread over the
+  /// following modules, so the call graph crosses module boundaries. Each
+  /// test calls one function of the first level and compares the result
+  /// against the value computed here, hence most of the add and negate
+  /// condition mutants are killed while the removed calls to the sink
+  /// survive. A test executes fanOut^(depth - 1) calls, keep both small.
+  class SyntheticProject {
+    SyntheticProjectOptions options;
+
+    std::string functionName(int module, int level, int index) const;
+    std::vector<std::pair<int, int>> callees(int module, int level, int index) const;
+
+    int32_t evaluate(int module, int level, int index, int32_t x) const;
+
+    std::unique_ptr<llvm::Module> createTesteeModule(int module,
+                                                     llvm::LLVMContext &context) const;
+    std::unique_ptr<llvm::Module> createTesterModule(int module,
+                                                     llvm::LLVMContext &context) const;
+
+    std::string createTesteeSource(int module) const;
+    std::string createTestSource(int module) const;
+
+  public:
+    explicit SyntheticProject(const SyntheticProjectOptions &options);
+
+    /// Mutation points of the project with all the operators enabled
+    uint64_t mutationPointCount() const;
+
+    /// SimpleTest style: the testee modules followed by the tester modules
+    std::vector<std::unique_ptr<llvm::Module>>
+    createSimpleTestModules(llvm::LLVMContext &context) const;
+
+    /// GoogleTest style: C++ sources with TEST() cases and a Makefile that
+    /// compiles them and GoogleTest itself to bitcode. GoogleTest cannot
+    /// be emitted as IR directly, the runner needs its real implementation.
+    std::vector<std::pair<std::string, std::string>> createGoogleTestSources() const;
+  };
+
+}
@@ -0,0 +1,156 @@
+#include "SyntheticProject.h"
+
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+#include <vector>
+
+using namespace Mutang;
+using namespace llvm;
+
+cl::OptionCategory MullGenerateOptionCategory("Mull Generate");
+
+enum class SuiteStyle { SimpleTest, GoogleTest };
+
+static cl::opt<SuiteStyle> Style(
+    "style",
+    llvm::cl::desc("Test framework of the generated suite:"),
+    llvm::cl::values(
+      clEnumValN(SuiteStyle::SimpleTest, "simple", "SimpleTest bitcode"),
+      clEnumValN(SuiteStyle::GoogleTest, "googletest", "GoogleTest C++ sources")),
+    llvm::cl::init(SuiteStyle::SimpleTest),
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static cl::opt<int> Modules(
+    "modules",
+    llvm::cl::desc("Number of testee modules."),
+    llvm::cl::init(4),
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static cl::opt<int> Depth(
+    "depth",
+    llvm::cl::desc("Levels of the call graph below each test."),
+    llvm::cl::init(3),
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static cl::opt<int> FanOut(
+    "fan-out",
+    llvm::cl::desc("Functions per level and calls made by each function."),
+    llvm::cl::init(2),
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static cl::opt<int> OperatorDensity(
+    "operator-density",
+    llvm::cl::desc("Mutation sites per function for each operator."),
+    llvm::cl::init(2),
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static cl::opt<std::string> OutputDirectory(
+    llvm::cl::desc("<output directory>"),
+    llvm::cl::Positional,
+    llvm::cl::Required,
+    llvm::cl::cat(MullGenerateOptionCategory)
+);
+
+static bool writeFile(const std::string &path, const std::string &contents) {
+  std::error_code EC;
+  raw_fd_ostream out(path, EC, sys::fs::F_Text);
+  if (EC) {
+    errs() << "Cannot write " << path << ": " << EC.message() << "\n";
+    return false;
+  }
+  out << contents;
+  return true;
+}
+
+static std::string pathInOutput(const std::string &name) {
+  SmallString<128> path(OutputDirectory);
+  sys::fs::make_absolute(path);
+  sys::path::append(path, name);
+  return path.str();
+}
+
+static bool writeConfig(const std::vector<std::string> &bitcodeFiles,
+                        const std::string &comment) {
+  std::string config = "# " + comment + "\nbitcode_files:\n";
+  for (auto &bitcodeFile : bitcodeFiles) {
+    config += "  - " + pathInOutput(bitcodeFile) + "\n";
+  }
+  return writeFile(pathInOutput("config.yml"), config);
+}
+
+static bool generateSimpleTest(const SyntheticProject &project) {
+  LLVMContext context;
+  std::vector<std::string> bitcodeFiles;
+
+  for (auto &module : project.createSimpleTestModules(context)) {
+    const std::string name = module->getModuleIdentifier() + ".bc";
+
+    std::error_code EC;
+    raw_fd_ostream out(pathInOutput(name), EC, sys::fs::F_None);
+    if (EC) {
+      errs() << "Cannot write " << name << ": " << EC.message() << "\n";
+      return false;
+    }
+    WriteBitcodeToFile(module.get(), out);
+    bitcodeFiles.push_back(name);
+  }
+
+  return writeConfig(bitcodeFiles, "Run with a driver using SimpleTestFinder and SimpleTestRunner");
+}
+
+static bool generateGoogleTest(const SyntheticProject &project) {
+  std::vector<std::string> bitcodeFiles;
+
+  for (auto &source : project.createGoogleTestSources()) {
+    if (!writeFile(pathInOutput(source.first), source.second)) {
+      return false;
+    }
+
+    StringRef name(source.first);
+    if (name.endswith(".cpp")) {
+      bitcodeFiles.push_back(name.drop_back(4).str() + ".bc");
+    }
+  }
+  bitcodeFiles.push_back("gtest-all.bc");
+
+  return writeConfig(bitcodeFiles, "Run make GTEST_DIR=... in this directory first");
+}
+
+int main(int argc, char *argv[]) {
+  cl::HideUnrelatedOptions(MullGenerateOptionCategory);
+  cl::ParseCommandLineOptions(argc, argv, "Generates synthetic test suites for Mull");
+
+  if (Modules < 1 || Depth < 1 || FanOut < 1 || OperatorDensity < 0) {
+    errs() << "The modules, depth and fan-out must be positive\n";
+    return EXIT_FAILURE;
+  }
+
+  if (std::error_code EC = sys::fs::create_directories(OutputDirectory)) {
+    errs() << "Cannot create " << OutputDirectory << ": " << EC.message() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  SyntheticProject project({ Modules, Depth, FanOut, OperatorDensity });
+
+  const bool written = Style == SuiteStyle::SimpleTest ? generateSimpleTest(project)
+                                                       : generateGoogleTest(project);
+  if (!written) {
+    return EXIT_FAILURE;
+  }
+
+  outs() << "Generated " << project.mutationPointCount() << " mutation points in "
+         << OutputDirectory << "\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+#include "SQLiteReporter.h"
+
+#include "llvm/Support/CommandLine.h"
+
+#include <string>
+#include <vector>
+
+using namespace Mutang;
+using namespace llvm;
+
+cl::OptionCategory MullMergeOptionCategory("Mull Merge");
+
+static cl::list<std::string> ShardDatabases(
+    llvm::cl::desc("<shard database>..."),
+    llvm::cl::Positional,
+    llvm::cl::OneOrMore,
+    llvm::cl::cat(MullMergeOptionCategory)
+);
+
+static cl::opt<std::string> OutputDatabase(
+    "o",
+    llvm::cl::desc("Path of the merged database, <timestamp>.sqlite in the current directory by default."),
+    llvm::cl::value_desc("path"),
+    llvm::cl::init(""),
+    llvm::cl::cat(MullMergeOptionCategory)
+);
+
+int main(int argc, char *argv[]) {
+  cl::HideUnrelatedOptions(MullMergeOptionCategory);
+  cl::ParseCommandLineOptions(argc, argv, "Merges the results of sharded Mull runs");
+
+  std::vector<std::string> shardDatabases(ShardDatabases.begin(),
+                                          ShardDatabases.end());
+
+  SQLiteReporter reporter;
+  if (!OutputDatabase.empty()) {
+    reporter.setDatabasePath(OutputDatabase);
+  }
+  reporter.mergeDatabases(shardDatabases);
+
+  return EXIT_SUCCESS;
+}
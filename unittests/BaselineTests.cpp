@@ -0,0 +1,215 @@
+#include "Baseline.h"
+#include "Context.h"
+#include "FunctionHasher.h"
+#include "MutangModule.h"
+#include "Result.h"
+#include "SQLiteReporter.h"
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include "gtest/gtest.h"
+
+#include <sqlite3.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+static LLVMContext Ctx;
+
+static std::unique_ptr<Module> parseModule(const char *IR) {
+  SMDiagnostic Err;
+  auto module = parseAssemblyString(IR, Err, Ctx);
+  assert(module && "Expected module to be parsed correctly");
+  return module;
+}
+
+TEST(FunctionHasher, hashFunction_IgnoresNumbering) {
+  auto original = parseModule("define i32 @sum(i32 %a, i32 %b) #0 {\n"
+                              "entry:\n"
+                              "  %add = add i32 %a, %b\n"
+                              "  ret i32 %add\n"
+                              "}\n"
+                              "attributes #0 = { nounwind }\n");
+
+  /// Another function comes first and takes the first attribute group
+  auto changed = parseModule("define void @other() #0 {\n"
+                             "entry:\n"
+                             "  ret void\n"
+                             "}\n"
+                             "define i32 @sum(i32 %a, i32 %b) #1 {\n"
+                             "entry:\n"
+                             "  %add = add i32 %a, %b\n"
+                             "  ret i32 %add\n"
+                             "}\n"
+                             "attributes #0 = { noinline }\n"
+                             "attributes #1 = { nounwind }\n");
+
+  FunctionHasher hasher;
+  ASSERT_EQ(hasher.hashFunction(*original->getFunction("sum")),
+            hasher.hashFunction(*changed->getFunction("sum")));
+}
+
+TEST(FunctionHasher, hashFunction_ChangedBody) {
+  auto original = parseModule("define i32 @sum(i32 %a, i32 %b) {\n"
+                              "entry:\n"
+                              "  %add = add i32 %a, %b\n"
+                              "  ret i32 %add\n"
+                              "}\n");
+
+  auto changed = parseModule("define i32 @sum(i32 %a, i32 %b) {\n"
+                             "entry:\n"
+                             "  %add = add nsw i32 %a, %b\n"
+                             "  ret i32 %add\n"
+                             "}\n");
+
+  FunctionHasher hasher;
+  ASSERT_NE(hasher.hashFunction(*original->getFunction("sum")),
+            hasher.hashFunction(*changed->getFunction("sum")));
+}
+
+TEST(FunctionHasher, hashFunction_ChangedGlobalInitializer) {
+  auto original = parseModule("@table = constant [2 x i32] [i32 1, i32 2]\n"
+                              "define i32 @second() {\n"
+                              "entry:\n"
+                              "  %value = load i32, i32* getelementptr inbounds "
+                              "([2 x i32], [2 x i32]* @table, i32 0, i32 1)\n"
+                              "  ret i32 %value\n"
+                              "}\n");
+
+  auto changed = parseModule("@table = constant [2 x i32] [i32 1, i32 3]\n"
+                             "define i32 @second() {\n"
+                             "entry:\n"
+                             "  %value = load i32, i32* getelementptr inbounds "
+                             "([2 x i32], [2 x i32]* @table, i32 0, i32 1)\n"
+                             "  ret i32 %value\n"
+                             "}\n");
+
+  FunctionHasher hasher;
+  ASSERT_NE(hasher.hashFunction(*original->getFunction("second")),
+            hasher.hashFunction(*changed->getFunction("second")));
+}
+
+TEST(FunctionHasher, hashFunction_ChangedString) {
+  auto original = parseModule("@message = constant [3 x i8] c\"#1\\00\"\n"
+                              "define i8* @message_of() {\n"
+                              "entry:\n"
+                              "  ret i8* getelementptr inbounds "
+                              "([3 x i8], [3 x i8]* @message, i32 0, i32 0)\n"
+                              "}\n");
+
+  auto changed = parseModule("@message = constant [3 x i8] c\"#2\\00\"\n"
+                             "define i8* @message_of() {\n"
+                             "entry:\n"
+                             "  ret i8* getelementptr inbounds "
+                             "([3 x i8], [3 x i8]* @message, i32 0, i32 0)\n"
+                             "}\n");
+
+  FunctionHasher hasher;
+  ASSERT_NE(hasher.hashFunction(*original->getFunction("message_of")),
+            hasher.hashFunction(*changed->getFunction("message_of")));
+}
+
+/// 'test' calls 'handler' through a table only, and 'helper' not at all
+static const char *ReachableTesterIR =
+  "@handlers = external global [1 x i32 ()*]\n"
+  "define i32 @helper() {\n"
+  "entry:\n"
+  "  ret i32 HELPER\n"
+  "}\n"
+  "define i32 @test() {\n"
+  "entry:\n"
+  "  %handler = load i32 ()*, i32 ()** getelementptr inbounds "
+  "([1 x i32 ()*], [1 x i32 ()*]* @handlers, i32 0, i32 0)\n"
+  "  %result = call i32 %handler()\n"
+  "  ret i32 %result\n"
+  "}\n";
+
+static const char *ReachableTesteeIR =
+  "@handlers = global [1 x i32 ()*] [i32 ()* @handler]\n"
+  "define i32 @handler() {\n"
+  "entry:\n"
+  "  ret i32 HANDLER\n"
+  "}\n"
+  "define i32 @unused() {\n"
+  "entry:\n"
+  "  ret i32 UNUSED\n"
+  "}\n";
+
+static std::string hashReachableCode(int helper, int handler, int unused) {
+  auto substitute = [](std::string ir, const std::string &name, int value) {
+    ir.replace(ir.find(name), name.size(), std::to_string(value));
+    return ir;
+  };
+
+  Context context;
+  context.addModule(make_unique<MutangModule>(
+    parseModule(substitute(ReachableTesterIR, "HELPER", helper).c_str()), "tester"));
+  context.addModule(make_unique<MutangModule>(
+    parseModule(substitute(substitute(ReachableTesteeIR, "HANDLER", handler),
+                           "UNUSED", unused).c_str()), "testee"));
+
+  Function *test = context.getModules().front()->getModule()->getFunction("test");
+  FunctionHasher hasher;
+  return hasher.hashReachableCode(*test, context);
+}
+
+TEST(FunctionHasher, hashReachableCode) {
+  const std::string original = hashReachableCode(1, 2, 3);
+
+  /// Reached through a function pointer only
+  ASSERT_NE(original, hashReachableCode(1, 4, 3));
+
+  /// Never called, but in the module of the test
+  ASSERT_NE(original, hashReachableCode(4, 2, 3));
+
+  /// Not reachable from the test at all
+  ASSERT_EQ(original, hashReachableCode(1, 2, 4));
+}
+
+TEST(Baseline, load_FindsResultsOfReporter) {
+  SQLiteReporter reporter;
+
+  std::vector<std::unique_ptr<TestResult>> results;
+  std::vector<Testee *> testees;
+  std::unique_ptr<Result> result = make_unique<Result>(std::move(results),
+                                                       std::move(testees));
+
+  unlink(reporter.getDatabasePath().c_str());
+  reporter.reportResults(result);
+
+  sqlite3 *database;
+  sqlite3_open(reporter.getDatabasePath().c_str(), &database);
+  sqlite3_exec(database,
+               "INSERT INTO execution_result VALUES"
+               "  (1, 42, 'out', 'err', 1000, 200, 4096, 1, 30, 5);"
+               "INSERT INTO test (test_name, execution_result_id, testees_hash)"
+               "  VALUES ('test_sum', 1, 'testees');"
+               "INSERT INTO mutation_point (unique_id, stable_id)"
+               "  VALUES ('unique', 'stable');"
+               "INSERT INTO mutation_result VALUES (1, 1, 1, 1);",
+               nullptr, nullptr, nullptr);
+  sqlite3_close(database);
+
+  Baseline baseline;
+  ASSERT_TRUE(baseline.load(reporter.getDatabasePath()));
+  ASSERT_EQ(1U, baseline.size());
+
+  const ExecutionResult *carried = baseline.findResult("test_sum", "testees", "stable");
+  ASSERT_NE(nullptr, carried);
+  ASSERT_EQ(ExecutionStatus::Failed, carried->Status);
+  ASSERT_EQ(42, carried->RunningTime);
+  ASSERT_EQ(1000, carried->Usage.UserTime);
+  ASSERT_EQ(200, carried->Usage.SystemTime);
+  ASSERT_EQ(4096, carried->Usage.MaxRSS);
+  ASSERT_EQ(1, carried->Usage.MajorFaults);
+  ASSERT_EQ(30, carried->Usage.MinorFaults);
+  ASSERT_EQ(5, carried->Usage.ContextSwitches);
+
+  ASSERT_EQ(nullptr, baseline.findResult("test_sum", "changed", "stable"));
+
+  unlink(reporter.getDatabasePath().c_str());
+}
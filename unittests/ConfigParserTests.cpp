@@ -160,3 +160,348 @@ TEST(ConfigParser, loadConfig_CacheDirectory_SpecificValue) {
 
   ASSERT_EQ("/var/tmp", Cfg.getCacheDirectory());
 }
+
+TEST(ConfigParser, loadConfig_EmitDebugInfo_Unspecified) {
+  /// Surprisingly enough, yaml library crashes on empty string so
+  /// providing 'bitcode_files:' with content just to overcome the assert.
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.shouldEmitDebugInfo());
+}
+
+TEST(ConfigParser, loadConfig_EmitDebugInfo_SpecificValue) {
+  yaml::Input Input("emit_debug_info: false\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.shouldEmitDebugInfo());
+}
+
+TEST(ConfigParser, loadConfig_Zygote_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.getZygote());
+}
+
+TEST(ConfigParser, loadConfig_Zygote_SpecificValue) {
+  yaml::Input Input("zygote: true\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.getZygote());
+}
+
+TEST(ConfigParser, loadConfig_MutantCentric_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.isMutantCentric());
+}
+
+TEST(ConfigParser, loadConfig_MutantCentric_SpecificValue) {
+  yaml::Input Input("mutant_centric: true\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.isMutantCentric());
+}
+
+TEST(ConfigParser, loadConfig_CoveragePruning_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.isCoveragePruningEnabled());
+}
+
+TEST(ConfigParser, loadConfig_CoveragePruning_SpecificValue) {
+  yaml::Input Input("coverage_pruning: true\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.isCoveragePruningEnabled());
+}
+
+TEST(ConfigParser, loadConfig_TimeoutPolicy_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(MutangDefaultTimeoutMultiplier, Cfg.getTimeoutMultiplier());
+  ASSERT_EQ(MutangDefaultMinimumTimeout, Cfg.getMinimumTimeout());
+  ASSERT_EQ(MutangDefaultMaximumTimeout, Cfg.getMaximumTimeout());
+  ASSERT_EQ(MutangDefaultTimingSamples, Cfg.getTimingSamples());
+}
+
+TEST(ConfigParser, loadConfig_TimeoutPolicy_SpecificValues) {
+  yaml::Input Input("timeout_multiplier: 2.5\n"
+                      "min_timeout: 50\n"
+                      "max_timeout: 1000\n"
+                      "timing_samples: 5\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(2.5, Cfg.getTimeoutMultiplier());
+  ASSERT_EQ(50, Cfg.getMinimumTimeout());
+  ASSERT_EQ(1000, Cfg.getMaximumTimeout());
+  ASSERT_EQ(5, Cfg.getTimingSamples());
+}
+
+TEST(ConfigParser, loadConfig_LoopBudget_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.isLoopBudgetEnabled());
+  ASSERT_EQ(MutangDefaultLoopBudgetMultiplier, Cfg.getLoopBudgetMultiplier());
+}
+
+TEST(ConfigParser, loadConfig_LoopBudget_SpecificValues) {
+  yaml::Input Input("loop_budget: true\n"
+                      "loop_budget_multiplier: 4\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.isLoopBudgetEnabled());
+  ASSERT_EQ(4, Cfg.getLoopBudgetMultiplier());
+}
+
+TEST(ConfigParser, loadConfig_EquivalentMutantPruning_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.isEquivalentMutantPruningEnabled());
+}
+
+TEST(ConfigParser, loadConfig_EquivalentMutantPruning_Enabled) {
+  yaml::Input Input("equivalent_mutant_pruning: true\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.isEquivalentMutantPruningEnabled());
+}
+
+TEST(ConfigParser, loadConfig_TrivialCompilerEquivalence_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_FALSE(Cfg.isTrivialCompilerEquivalenceEnabled());
+}
+
+TEST(ConfigParser, loadConfig_TrivialCompilerEquivalence_Enabled) {
+  yaml::Input Input("trivial_compiler_equivalence: true\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.isTrivialCompilerEquivalenceEnabled());
+}
+
+TEST(ConfigParser, loadConfig_MutationOperators_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.getMutationOperators().empty());
+}
+
+TEST(ConfigParser, loadConfig_MutationOperators_List) {
+  yaml::Input Input("mutation_operators:\n"
+                      "  - add_mutation_operator\n"
+                      "  - negate_mutation_operator\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(2U, Cfg.getMutationOperators().size());
+  ASSERT_EQ("add_mutation_operator", Cfg.getMutationOperators()[0]);
+  ASSERT_EQ("negate_mutation_operator", Cfg.getMutationOperators()[1]);
+}
+
+TEST(ConfigParser, loadConfig_FunctionFilters_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_TRUE(Cfg.getIncludeLocations().empty());
+  ASSERT_TRUE(Cfg.getExcludeLocations().empty());
+  ASSERT_TRUE(Cfg.getIncludeFunctions().empty());
+  ASSERT_TRUE(Cfg.getExcludeFunctions().empty());
+}
+
+TEST(ConfigParser, loadConfig_FunctionFilters_Lists) {
+  yaml::Input Input("include_locations:\n"
+                      "  - \"*/src/*\"\n"
+                      "exclude_locations:\n"
+                      "  - \"*/third_party/*\"\n"
+                      "  - \"*/generated/*\"\n"
+                      "include_functions:\n"
+                      "  - \"llvm::*\"\n"
+                      "exclude_functions:\n"
+                      "  - \"_ZN7testing*\"\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(1U, Cfg.getIncludeLocations().size());
+  ASSERT_EQ(2U, Cfg.getExcludeLocations().size());
+  ASSERT_EQ("*/generated/*", Cfg.getExcludeLocations()[1]);
+  ASSERT_EQ(1U, Cfg.getIncludeFunctions().size());
+  ASSERT_EQ("_ZN7testing*", Cfg.getExcludeFunctions()[0]);
+}
+
+TEST(ConfigParser, loadConfig_Baseline_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ("", Cfg.getBaselineDatabase());
+}
+
+TEST(ConfigParser, loadConfig_Baseline_SpecificValue) {
+  yaml::Input Input("baseline: /tmp/1490000000.sqlite\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ("/tmp/1490000000.sqlite", Cfg.getBaselineDatabase());
+}
+
+TEST(ConfigParser, loadConfig_Shard_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(0, Cfg.getShardIndex());
+  ASSERT_EQ(1, Cfg.getShardCount());
+}
+
+TEST(ConfigParser, loadConfig_Shard_SpecificValues) {
+  yaml::Input Input("shard_index: 2\n"
+                      "shard_count: 4\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(2, Cfg.getShardIndex());
+  ASSERT_EQ(4, Cfg.getShardCount());
+}
+
+TEST(ConfigParser, loadConfig_Workers_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(0, Cfg.getWorkers());
+  ASSERT_EQ("", Cfg.getWorkerSocket());
+  ASSERT_EQ("", Cfg.getWorkerCommand());
+}
+
+TEST(ConfigParser, loadConfig_Workers_SpecificValues) {
+  yaml::Input Input("workers: 4\n"
+                      "worker_socket: /tmp/mutang.sock\n"
+                      "worker_command: mutang-driver -worker={socket} config.yml\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(4, Cfg.getWorkers());
+  ASSERT_EQ("/tmp/mutang.sock", Cfg.getWorkerSocket());
+  ASSERT_EQ("mutang-driver -worker={socket} config.yml", Cfg.getWorkerCommand());
+}
+
+TEST(ConfigParser, loadConfig_TraceFile_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ("", Cfg.getTraceFile());
+}
+
+TEST(ConfigParser, loadConfig_TraceFile_SpecificValue) {
+  yaml::Input Input("trace_file: /tmp/mutang_trace.json\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ("/tmp/mutang_trace.json", Cfg.getTraceFile());
+}
+
+TEST(ConfigParser, loadConfig_ResourceLimits_Unspecified) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo.bc\n"
+                      "  - bar.bc\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(0, Cfg.getMemoryLimit());
+  ASSERT_EQ(0, Cfg.getCPULimit());
+}
+
+TEST(ConfigParser, loadConfig_ResourceLimits_SpecificValues) {
+  yaml::Input Input("memory_limit: 512\n"
+                      "cpu_limit: 30\n");
+
+  ConfigParser Parser;
+  auto Cfg = Parser.loadConfig(Input);
+
+  ASSERT_EQ(512, Cfg.getMemoryLimit());
+  ASSERT_EQ(30, Cfg.getCPULimit());
+}
@@ -1,7 +1,9 @@
 #include "Config.h"
+#include "ConfigParser.h"
 #include "Context.h"
 #include "Driver.h"
 #include "ModuleLoader.h"
+#include "MutationPoint.h"
 #include "MutationOperators/AddMutationOperator.h"
 #include "MutationOperators/NegateConditionMutationOperator.h"
 #include "MutationOperators/RemoveVoidFunctionMutationOperator.h"
@@ -10,11 +12,13 @@
 #include "SimpleTest/SimpleTestRunner.h"
 #include "TestModuleFactory.h"
 #include "TestResult.h"
+#include "WorkerProtocol.h"
 
 #include "Toolchain/Toolchain.h"
 
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Twine.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Casting.h"
@@ -25,6 +29,11 @@
 
 #include "gtest/gtest.h"
 
+#include <map>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
 using namespace Mutang;
 using namespace llvm;
 
@@ -77,6 +86,36 @@ public:
       return make_unique<MutangModule>(std::move(module), "simple_test/testee_path_calculation/testee");
     }
 
+    else if (path == "simple_test/mutant_centric/tester") {
+      auto module = TestModuleFactory.create_SimpleTest_MutantCentric_Tester_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/mutant_centric/tester");
+    }
+
+    else if (path == "simple_test/mutant_centric/testee") {
+      auto module = TestModuleFactory.create_SimpleTest_MutantCentric_Testee_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/mutant_centric/testee");
+    }
+
+    else if (path == "simple_test/coverage_pruning/tester") {
+      auto module = TestModuleFactory.create_SimpleTest_CoveragePruning_Tester_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/coverage_pruning/tester");
+    }
+
+    else if (path == "simple_test/coverage_pruning/testee") {
+      auto module = TestModuleFactory.create_SimpleTest_CoveragePruning_Testee_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/coverage_pruning/testee");
+    }
+
+    else if (path == "simple_test/trivial_compiler_equivalence/tester") {
+      auto module = TestModuleFactory.create_SimpleTest_TrivialCompilerEquivalence_Tester_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/trivial_compiler_equivalence/tester");
+    }
+
+    else if (path == "simple_test/trivial_compiler_equivalence/testee") {
+      auto module = TestModuleFactory.create_SimpleTest_TrivialCompilerEquivalence_Testee_Module();
+      return make_unique<MutangModule>(std::move(module), "simple_test/trivial_compiler_equivalence/testee");
+    }
+
     return make_unique<MutangModule>(nullptr, "");
   }
 };
@@ -131,6 +170,238 @@ TEST(Driver, SimpleTest_AddMutationOperator) {
   ASSERT_NE(nullptr, FirstMutant->getMutationPoint());
 }
 
+TEST(Driver, SimpleTest_AddMutationOperator_MutantCentric) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo\n"
+                      "  - bar\n"
+                      "fork: false\n"
+                      "use_cache: false\n"
+                      "max_distance: 10\n"
+                      "mutant_centric: true\n");
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  llvm::TargetMachine &machine = toolchain.targetMachine();
+  SimpleTestRunner runner(machine);
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  /// The only test reaching the mutant kills it
+  auto result = Driver.Run();
+  ASSERT_EQ(1u, result->getTestResults().size());
+
+  auto FirstResult = result->getTestResults().begin()->get();
+  ASSERT_EQ(ExecutionStatus::Passed, FirstResult->getOriginalTestResult().Status);
+
+  auto &Mutants = FirstResult->getMutationResults();
+  ASSERT_EQ(1u, Mutants.size());
+
+  auto FirstMutant = Mutants.begin()->get();
+  ASSERT_EQ(ExecutionStatus::Failed, FirstMutant->getExecutionResult().Status);
+  ASSERT_EQ(1, FirstMutant->getMutationDistance());
+}
+
+TEST(Driver, SimpleTest_AddMutationOperator_MutantCentric_SeveralTests) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - simple_test/mutant_centric/tester\n"
+                      "  - simple_test/mutant_centric/testee\n"
+                      "fork: false\n"
+                      "use_cache: false\n"
+                      "max_distance: 10\n"
+                      "mutant_centric: true\n");
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  auto result = Driver.Run();
+  ASSERT_EQ(3u, result->getTestResults().size());
+
+  std::map<std::string, TestResult *> results;
+  for (auto &testResult : result->getTestResults()) {
+    ASSERT_EQ(ExecutionStatus::Passed, testResult->getOriginalTestResult().Status);
+    results[testResult->getTestName()] = testResult.get();
+  }
+
+  /// The mutant of 'first' is reached by all three tests. The closer ones
+  /// run first, test_weak before test_strong in the order of discovery.
+  /// test_strong kills it, so test_far is never run.
+  ///
+  /// The mutant of 'second' is reached by test_weak and test_strong at the
+  /// same distance. test_strong has killed a mutant already, it runs first
+  /// and kills this one too, so test_weak is never run.
+  ASSERT_EQ(0u, results["test_far"]->getMutationResults().size());
+
+  auto &WeakMutants = results["test_weak"]->getMutationResults();
+  ASSERT_EQ(1u, WeakMutants.size());
+  ASSERT_EQ(ExecutionStatus::Passed, WeakMutants[0]->getExecutionResult().Status);
+  ASSERT_EQ("first", WeakMutants[0]->getTestee()->getTesteeFunction()->getName());
+
+  auto &StrongMutants = results["test_strong"]->getMutationResults();
+  ASSERT_EQ(2u, StrongMutants.size());
+  ASSERT_EQ(ExecutionStatus::Failed, StrongMutants[0]->getExecutionResult().Status);
+  ASSERT_EQ(ExecutionStatus::Failed, StrongMutants[1]->getExecutionResult().Status);
+}
+
+TEST(Driver, SimpleTest_AddMutationOperator_CoveragePruning) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - foo\n"
+                      "  - bar\n"
+                      "fork: false\n"
+                      "use_cache: false\n"
+                      "max_distance: 10\n"
+                      "coverage_pruning: true\n");
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  llvm::TargetMachine &machine = toolchain.targetMachine();
+  SimpleTestRunner runner(machine);
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  /// The test executes the mutated instruction, so the mutant
+  /// is run against the instrumented original and killed
+  auto result = Driver.Run();
+  ASSERT_EQ(1u, result->getTestResults().size());
+
+  auto FirstResult = result->getTestResults().begin()->get();
+  ASSERT_EQ(ExecutionStatus::Passed, FirstResult->getOriginalTestResult().Status);
+
+  auto &Mutants = FirstResult->getMutationResults();
+  ASSERT_EQ(1u, Mutants.size());
+
+  auto FirstMutant = Mutants.begin()->get();
+  ASSERT_EQ(ExecutionStatus::Failed, FirstMutant->getExecutionResult().Status);
+}
+
+TEST(Driver, SimpleTest_AddMutationOperator_CoveragePruning_NotCovered) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - simple_test/coverage_pruning/tester\n"
+                      "  - simple_test/coverage_pruning/testee\n"
+                      "fork: false\n"
+                      "use_cache: false\n"
+                      "max_distance: 10\n"
+                      "coverage_pruning: true\n");
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  auto result = Driver.Run();
+  ASSERT_EQ(1u, result->getTestResults().size());
+
+  auto FirstResult = result->getTestResults().begin()->get();
+  ASSERT_EQ(ExecutionStatus::Passed, FirstResult->getOriginalTestResult().Status);
+
+  /// The mutant in the 'negative' block would survive if it was run,
+  /// the test never gets there
+  auto &Mutants = FirstResult->getMutationResults();
+  ASSERT_EQ(2u, Mutants.size());
+
+  std::map<std::string, MutationResult *> mutants;
+  for (auto &mutant : Mutants) {
+    Instruction *instruction =
+      cast<Instruction>(mutant->getMutationPoint()->getOriginalValue());
+    mutants[instruction->getParent()->getName().str()] = mutant.get();
+  }
+
+  ASSERT_EQ(ExecutionStatus::NotCovered, mutants["negative"]->getExecutionResult().Status);
+  ASSERT_EQ(0, mutants["negative"]->getExecutionResult().RunningTime);
+  ASSERT_EQ(ExecutionStatus::Failed, mutants["positive"]->getExecutionResult().Status);
+}
+
+TEST(Driver, SimpleTest_AddMutationOperator_TrivialCompilerEquivalence) {
+  yaml::Input Input("bitcode_files:\n"
+                      "  - simple_test/trivial_compiler_equivalence/tester\n"
+                      "  - simple_test/trivial_compiler_equivalence/testee\n"
+                      "fork: false\n"
+                      "use_cache: false\n"
+                      "max_distance: 10\n"
+                      "trivial_compiler_equivalence: true\n");
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  auto result = Driver.Run();
+  ASSERT_EQ(2u, result->getTestResults().size());
+
+  std::map<std::string, TestResult *> results;
+  for (auto &testResult : result->getTestResults()) {
+    ASSERT_EQ(ExecutionStatus::Passed, testResult->getOriginalTestResult().Status);
+    results[testResult->getTestName()] = testResult.get();
+  }
+
+  /// The mutants of 'f' and 'h' compile to the same code, yet only the one
+  /// of 'h' is killed: they do not share a result
+  std::map<std::string, ExecutionStatus> fh;
+  for (auto &mutant : results["test_fh"]->getMutationResults()) {
+    fh[mutant->getTestee()->getTesteeFunction()->getName().str()] =
+      mutant->getExecutionResult().Status;
+  }
+  ASSERT_EQ(2u, fh.size());
+  ASSERT_EQ(ExecutionStatus::Passed, fh["f"]);
+  ASSERT_EQ(ExecutionStatus::Failed, fh["h"]);
+
+  /// The first mutant of 'g' compiles to the same code as 'f' does, it is
+  /// not equivalent to 'g' though
+  auto &GMutants = results["test_g"]->getMutationResults();
+  ASSERT_EQ(2u, GMutants.size());
+  ASSERT_EQ(ExecutionStatus::Failed, GMutants[0]->getExecutionResult().Status);
+  ASSERT_EQ(ExecutionStatus::Failed, GMutants[1]->getExecutionResult().Status);
+}
+
 TEST(Driver, SimpleTest_NegateConditionMutationOperator) {
   /// Create Config with fake BitcodePaths
   /// Create Fake Module Loader
@@ -278,11 +549,11 @@ TEST(Driver, SimpleTest_TesteePathCalculation) {
   auto &allTestees = result->getAllTestees();
   ASSERT_EQ(5U, allTestees.size());
 
-  Testee *testee1 = allTestees[0].get();
-  Testee *testee2 = allTestees[1].get();
-  Testee *testee3 = allTestees[2].get();
-  Testee *testee4 = allTestees[3].get();
-  Testee *testee5 = allTestees[4].get();
+  Testee *testee1 = allTestees[0];
+  Testee *testee2 = allTestees[1];
+  Testee *testee3 = allTestees[2];
+  Testee *testee4 = allTestees[3];
+  Testee *testee5 = allTestees[4];
 
   ASSERT_EQ(firstMutant->getTestee(), testee5);
 
@@ -325,3 +596,136 @@ TEST(Driver, SimpleTest_TesteePathCalculation) {
   ASSERT_EQ(callerPath[3], "testee.c:15");
   ASSERT_EQ(callerPath[4], "testee.c:8");
 }
+
+/// Test name, then the testee and the status of each of its mutants in the
+/// order they are reported
+typedef std::map<std::string, std::vector<std::pair<std::string, ExecutionStatus>>>
+  MutantStatuses;
+
+/// Runs the add mutants of the mutant-centric fixture, the mode and the
+/// workers come with extraConfig
+static MutantStatuses runAddMutationFixture(const std::string &extraConfig) {
+  std::string configText = "bitcode_files:\n"
+                           "  - simple_test/mutant_centric/tester\n"
+                           "  - simple_test/mutant_centric/testee\n"
+                           "fork: false\n"
+                           "use_cache: false\n"
+                           "max_distance: 10\n" + extraConfig;
+  yaml::Input Input(configText);
+
+  ConfigParser Parser;
+  Config config = Parser.loadConfig(Input);
+
+  FakeModuleLoader loader;
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  Toolchain toolchain(config);
+  SimpleTestRunner runner(toolchain.targetMachine());
+
+  Driver Driver(config, loader, testFinder, runner, toolchain);
+
+  MutantStatuses statuses;
+  auto result = Driver.Run();
+  for (auto &testResult : result->getTestResults()) {
+    auto &mutants = statuses[testResult->getTestName()];
+    for (auto &mutant : testResult->getMutationResults()) {
+      mutants.push_back(std::make_pair(mutant->getTestee()->getTesteeFunction()->getName().str(),
+                                       mutant->getExecutionResult().Status));
+    }
+  }
+  return statuses;
+}
+
+TEST(Driver, SimpleTest_Workers_SameResultsAsInProcess) {
+  MutantStatuses inProcess = runAddMutationFixture("mutant_centric: false\nworkers: 0\n");
+  MutantStatuses onWorkers = runAddMutationFixture("mutant_centric: false\nworkers: 2\n");
+
+  ASSERT_EQ(3u, inProcess.size());
+  ASSERT_EQ(5u, inProcess["test_far"].size() + inProcess["test_weak"].size() +
+                inProcess["test_strong"].size());
+  ASSERT_EQ(inProcess, onWorkers);
+}
+
+/// Connects once the coordinator listens on the socket
+static int connectToCoordinator(const std::string &socketPath) {
+  for (int attempt = 0; attempt < 500; attempt++) {
+    struct stat status;
+    if (stat(socketPath.c_str(), &status) == 0) {
+      const int fd = WorkerChannel::connectTo(socketPath);
+      if (fd != -1) {
+        return fd;
+      }
+    }
+    usleep(10000);
+  }
+  return -1;
+}
+
+TEST(Driver, SimpleTest_Workers_JobOfLostWorkerIsHandedOutAgain) {
+  const std::string socketPath = "/tmp/mutang_driver_workers_test.sock";
+  unlink(socketPath.c_str());
+
+  /// The coordinator keeps handing out jobs while one of its workers is
+  /// alive: this one only waits for the socket to go away (or ten seconds
+  /// to pass), the jobs are run by the fake workers below
+  const std::string extraConfig =
+    "mutant_centric: false\n"
+    "workers: 1\n"
+    "worker_socket: " + socketPath + "\n"
+    "worker_command: 'for i in $(seq 100); do [ -S {socket} ] || break; sleep 0.1; done'\n";
+
+  uint64_t lostJob = 0;
+  std::vector<uint64_t> finishedJobs;
+
+  std::thread workers([&]() {
+    {
+      /// Goes away in the middle of its job, just like a killed worker
+      WorkerChannel lost(connectToCoordinator(socketPath));
+      std::vector<std::string> message;
+      WorkerJob job;
+      if (!lost.send({ WorkerMessage::Ready }) || !lost.receive(message) ||
+          !WorkerChannel::decodeJob(message, job)) {
+        return;
+      }
+      lostJob = job.id;
+    }
+
+    WorkerChannel channel(connectToCoordinator(socketPath));
+    if (!channel.send({ WorkerMessage::Ready })) {
+      return;
+    }
+
+    std::vector<std::string> message;
+    WorkerJob job;
+    while (channel.receive(message) && WorkerChannel::decodeJob(message, job)) {
+      finishedJobs.push_back(job.id);
+
+      ExecutionResult result;
+      result.Status = ExecutionStatus::Crashed;
+      result.RunningTime = 1;
+      if (!channel.sendResult(job.id, result)) {
+        return;
+      }
+    }
+  });
+
+  MutantStatuses statuses = runAddMutationFixture(extraConfig);
+  workers.join();
+
+  ASSERT_FALSE(finishedJobs.empty());
+  ASSERT_EQ(lostJob, finishedJobs.front());
+
+  /// Every job is run once by the remaining worker, none by the coordinator
+  size_t mutants = 0;
+  for (auto &test : statuses) {
+    for (auto &mutant : test.second) {
+      ASSERT_EQ(ExecutionStatus::Crashed, mutant.second);
+      mutants++;
+    }
+  }
+  ASSERT_EQ(finishedJobs.size(), mutants);
+}
@@ -0,0 +1,53 @@
+#include "EquivalentMutantFilter.h"
+#include "MutangModule.h"
+#include "MutationPoint.h"
+#include "MutationOperators/AddMutationOperator.h"
+#include "TestModuleFactory.h"
+
+#include "llvm/IR/Module.h"
+
+#include "gtest/gtest.h"
+
+using namespace Mutang;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static Instruction *FirstInstruction(Module &module, StringRef functionName) {
+  return &*module.getFunction(functionName)->getEntryBlock().begin();
+}
+
+TEST(EquivalentMutantFilter, shouldSkip_AddOfZero) {
+  auto mutangModule = make_unique<MutangModule>(TestModuleFactory.createEquivalentMutantsModule(), "");
+  Module &module = *mutangModule->getModule();
+
+  AddMutationOperator mutationOperator;
+  MutationPoint point(&mutationOperator,
+                      MutationPointAddress(0, 0, 0),
+                      FirstInstruction(module, "add_zero"),
+                      mutangModule.get());
+
+  EquivalentMutantFilter filter;
+  ASSERT_TRUE(filter.shouldSkip(&point));
+  ASSERT_EQ(1, filter.getEquivalentCount());
+  ASSERT_EQ(0, filter.getRedundantCount());
+}
+
+TEST(EquivalentMutantFilter, shouldSkip_KeepsRealMutants) {
+  auto mutangModule = make_unique<MutangModule>(TestModuleFactory.createEquivalentMutantsModule(), "");
+  Module &module = *mutangModule->getModule();
+
+  AddMutationOperator mutationOperator;
+  MutationPoint point(&mutationOperator,
+                      MutationPointAddress(1, 0, 0),
+                      FirstInstruction(module, "sum"),
+                      mutangModule.get());
+
+  EquivalentMutantFilter filter;
+  ASSERT_FALSE(filter.shouldSkip(&point));
+
+  /// The verdict is remembered, the point is not a duplicate of itself
+  ASSERT_FALSE(filter.shouldSkip(&point));
+  ASSERT_EQ(0, filter.getEquivalentCount());
+  ASSERT_EQ(0, filter.getRedundantCount());
+}
@@ -1,8 +1,14 @@
 #include "ForkProcessSandbox.h"
+#include "LoopBudget.h"
 #include "TestResult.h"
 
 #include "gtest/gtest.h"
 
+#include <csignal>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
 using namespace Mutang;
 using namespace llvm;
 
@@ -34,3 +40,123 @@ TEST(ForkProcessSandbox, CaptureOutputFromChildProcess) {
   ASSERT_EQ(strcmp(result.stdoutOutput.c_str(), StdoutMessage), 0);
   ASSERT_EQ(strcmp(result.stderrOutput.c_str(), StderrMessage), 0);
 }
+
+TEST(ForkProcessSandbox, CollectsResourceUsageOfChildProcess) {
+  static const long long Timeout = 1000;
+  static const size_t Size = 64 * 1024 * 1024;
+
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    /// Touching every page makes the memory resident
+    volatile char *memory = (volatile char *)malloc(Size);
+    for (size_t i = 0; i < Size; i += 4096) {
+      memory[i] = 1;
+    }
+
+    ExecutionResult R;
+    R.Status = Passed;
+    R.RunningTime = 1;
+    *SharedResult = R;
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, Passed);
+  ASSERT_GE(result.Usage.MaxRSS, (long)(Size / 1024));
+  ASSERT_GE(result.Usage.MinorFaults, (long)(Size / 4096 / 2));
+  ASSERT_GE(result.Usage.UserTime + result.Usage.SystemTime, 0);
+}
+
+TEST(ForkProcessSandbox, CollectsResourceUsageOfTimedOutProcess) {
+  static const long long Timeout = 50;
+
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    volatile unsigned long long counter = 0;
+    while (true) {
+      counter++;
+    }
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, Timedout);
+  ASSERT_GT(result.Usage.UserTime + result.Usage.SystemTime, 0);
+}
+
+TEST(ForkProcessSandbox, MemoryLimitEndsRunawayAllocation) {
+  static const long long Timeout = 5000;
+  static const long long MemoryLimit = 64;
+
+  ForkProcessSandbox sandbox(MemoryLimit, 0);
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    std::vector<char *> chunks;
+    while (true) {
+      chunks.push_back(new char[16 * 1024 * 1024]);
+    }
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, ResourceLimitExceeded);
+}
+
+TEST(ForkProcessSandbox, MemoryLimitEndsRunawayMalloc) {
+  static const long long Timeout = 5000;
+  static const long long MemoryLimit = 64;
+
+  ForkProcessSandbox sandbox(MemoryLimit, 0);
+
+  /// Like C code not checking the result, it faults once malloc fails
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    while (true) {
+      volatile char *chunk = static_cast<char *>(malloc(16 * 1024 * 1024));
+      chunk[0] = 1;
+    }
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, ResourceLimitExceeded);
+}
+
+TEST(ForkProcessSandbox, CrashWithinLimitsIsCrash) {
+  static const long long Timeout = 5000;
+
+  ForkProcessSandbox sandbox(64, 10);
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    raise(SIGKILL);
+  }, Timeout);
+  ASSERT_EQ(result.Status, Crashed);
+
+  result = sandbox.run([&](ExecutionResult *SharedResult) {
+    volatile char *nowhere = nullptr;
+    nowhere[0] = 1;
+  }, Timeout);
+  ASSERT_EQ(result.Status, Crashed);
+}
+
+TEST(ForkProcessSandbox, CPULimitEndsBusyLoop) {
+  static const long long Timeout = 10000;
+  static const long long CPULimit = 1;
+
+  ForkProcessSandbox sandbox(0, CPULimit);
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    volatile unsigned long long counter = 0;
+    while (true) {
+      counter++;
+    }
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, ResourceLimitExceeded);
+  ASSERT_GT(result.Usage.UserTime + result.Usage.SystemTime, 0);
+}
+
+TEST(ForkProcessSandbox, LoopBudgetExitCodeIsLoopBudgetExceeded) {
+  static const long long Timeout = 1000;
+
+  ForkProcessSandbox sandbox;
+
+  ExecutionResult result = sandbox.run([&](ExecutionResult *SharedResult) {
+    _exit(LoopBudgetExceededExitCode);
+  }, Timeout);
+
+  ASSERT_EQ(result.Status, LoopBudgetExceeded);
+}
@@ -0,0 +1,72 @@
+#include "FunctionFilter.h"
+
+#include "ConfigParser.h"
+
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+#include "gtest/gtest.h"
+
+using namespace Mutang;
+using namespace llvm;
+
+static LLVMContext Ctx;
+
+static Function *createFunction(Module &module, StringRef name) {
+  FunctionType *type = FunctionType::get(Type::getVoidTy(Ctx), false);
+  return Function::Create(type, Function::ExternalLinkage, name, &module);
+}
+
+TEST(FunctionFilter, shouldSkipFunction_NoPatterns) {
+  Module module("filter", Ctx);
+  Function *function = createFunction(module, "foo");
+
+  FunctionFilter filter({}, {}, {}, {});
+
+  ASSERT_FALSE(filter.shouldSkipFunction(*function));
+}
+
+TEST(FunctionFilter, shouldSkipFunction_DemangledNames) {
+  Module module("filter", Ctx);
+  /// llvm::APInt::flipAllBits()
+  Function *member = createFunction(module, "_ZN4llvm5APInt11flipAllBitsEv");
+  /// testing::internal::String::Format()
+  Function *gtest = createFunction(module, "_ZN7testing8internal6String6FormatEv");
+  Function *plain = createFunction(module, "sum");
+
+  FunctionFilter filter({}, {}, { "llvm::*", "sum" }, { "*flipAllBits*" });
+
+  ASSERT_TRUE(filter.shouldSkipFunction(*member));
+  ASSERT_TRUE(filter.shouldSkipFunction(*gtest));
+  ASSERT_FALSE(filter.shouldSkipFunction(*plain));
+}
+
+TEST(FunctionFilter, shouldSkipFunction_MangledNames) {
+  Module module("filter", Ctx);
+  Function *gtest = createFunction(module, "_ZN7testing8internal6String6FormatEv");
+  Function *plain = createFunction(module, "sum");
+
+  FunctionFilter filter({}, {}, {}, { "_ZN7testing*" });
+
+  ASSERT_TRUE(filter.shouldSkipFunction(*gtest));
+  ASSERT_FALSE(filter.shouldSkipFunction(*plain));
+}
+
+TEST(FunctionFilter, shouldSkipFunction_LocationsWithoutDebugInfo) {
+  Module module("filter", Ctx);
+  Function *function = createFunction(module, "sum");
+
+  FunctionFilter excluding({}, { "*/third_party/*" }, {}, {});
+  FunctionFilter including({ "*/src/*" }, {}, {}, {});
+
+  /// Nothing to exclude, but nothing to include either
+  ASSERT_FALSE(excluding.shouldSkipFunction(*function));
+  ASSERT_TRUE(including.shouldSkipFunction(*function));
+}
+
+TEST(FunctionFilter, RefusesInvalidPattern) {
+  ASSERT_EXIT(FunctionFilter({}, {}, { "sum", "[a-" }, {}),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+}
@@ -2,6 +2,7 @@
 
 #include "Context.h"
 #include "MutationOperators/AddMutationOperator.h"
+#include "MutationOperators/MutationOperatorRegistry.h"
 #include "TestModuleFactory.h"
 #include "GoogleTest/GoogleTest_Test.h"
 
@@ -25,7 +26,8 @@ TEST(GoogleTestFinder, FindTest) {
   Context Ctx;
   Ctx.addModule(std::move(mutangModuleWithTests));
 
-  GoogleTestFinder finder;
+  MutationOperatorRegistry registry;
+  GoogleTestFinder finder(registry.createOperators({}));
 
   auto tests = finder.findTests(Ctx);
 
@@ -48,14 +50,15 @@ TEST(GoogleTestFinder, DISABLED_FindTestee) {
   Ctx.addModule(std::move(mutangModuleWithTests));
   Ctx.addModule(std::move(mutangModuleWithTestees));
 
-  GoogleTestFinder Finder;
+  MutationOperatorRegistry registry;
+  GoogleTestFinder Finder(registry.createOperators({}));
   auto Tests = Finder.findTests(Ctx);
 
   ASSERT_NE(0u, Tests.size());
 
   auto &Test = *(Tests.begin());
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(1U, Testees.size());
 
@@ -74,28 +77,27 @@ TEST(GoogleTestFinder, DISABLED_FindMutationPoints) {
   Ctx.addModule(std::move(mutangModuleWithTests));
   Ctx.addModule(std::move(mutangModuleWithTestees));
 
-  GoogleTestFinder Finder;
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+  GoogleTestFinder Finder(std::move(mutationOperators));
   auto Tests = Finder.findTests(Ctx);
 
   ASSERT_NE(0u, Tests.size());
 
   auto &Test = *Tests.begin();
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(1U, Testees.size());
 
   Function *Testee = Testees[0]->getTesteeFunction();
   ASSERT_FALSE(Testee->empty());
 
-  AddMutationOperator MutOp;
-  std::vector<MutationOperator *> MutOps({&MutOp});
-
-  std::vector<std::unique_ptr<MutationPoint>> MutationPoints = Finder.findMutationPoints(MutOps, *Testee);
+  std::vector<MutationPoint *> MutationPoints = Finder.findMutationPoints(Ctx, *Testee);
   ASSERT_EQ(1U, MutationPoints.size());
 
-  MutationPoint *MP = (*(MutationPoints.begin())).get();
-  ASSERT_EQ(&MutOp, MP->getOperator());
+  MutationPoint *MP = *MutationPoints.begin();
+  ASSERT_EQ("add_mutation_operator", MP->getOperator()->uniqueID());
   ASSERT_TRUE(isa<BinaryOperator>(MP->getOriginalValue()));
 
   MutationPointAddress MPA = MP->getAddress();
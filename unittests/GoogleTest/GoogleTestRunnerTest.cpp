@@ -0,0 +1,114 @@
+#include "GoogleTest/GoogleTestRunner.h"
+
+#include "TestModuleFactory.h"
+#include "Toolchain/Compiler.h"
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/Support/TargetSelect.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Mutang;
+using namespace llvm;
+
+static TestModuleFactory TestModuleFactory;
+
+static std::vector<int> destroyed;
+
+static void recordDestruction(void *arg) {
+  destroyed.push_back(*static_cast<int *>(arg));
+}
+
+/// Exposes the hooks the object layer calls
+class TestableGoogleTestRunner : public GoogleTestRunner {
+public:
+  TestableGoogleTestRunner(TargetMachine &machine) : GoogleTestRunner(machine) {}
+
+  using GoogleTestRunner::createResolver;
+  using GoogleTestRunner::willUnloadObjectFiles;
+};
+
+TEST(GoogleTestRunner, cxa_atexit_MoreThan64Registrations) {
+  runDestructors();
+  destroyed.clear();
+
+  int dsoHandle = 0;
+  std::vector<int> objects(100);
+  for (int i = 0; i < 100; i++) {
+    objects[i] = i;
+    mutang__cxa_atexit(recordDestruction, &objects[i], &dsoHandle);
+  }
+
+  runDestructors();
+
+  ASSERT_EQ(100U, destroyed.size());
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(99 - i, destroyed[i]);
+  }
+}
+
+TEST(GoogleTestRunner, cxa_atexit_DuplicateRegistrationRunsOnce) {
+  runDestructors();
+  destroyed.clear();
+
+  int dsoHandle = 0;
+  int otherDSOHandle = 0;
+  int object = 42;
+  mutang__cxa_atexit(recordDestruction, &object, &dsoHandle);
+  mutang__cxa_atexit(recordDestruction, &object, &dsoHandle);
+
+  /// The same argument within another dso is a different registration
+  mutang__cxa_atexit(recordDestruction, &object, &otherDSOHandle);
+
+  runDestructors();
+  ASSERT_EQ(std::vector<int>({ 42, 42 }), destroyed);
+
+  /// Once run, the destructor may be registered again
+  destroyed.clear();
+  mutang__cxa_atexit(recordDestruction, &object, &dsoHandle);
+  runDestructors();
+  ASSERT_EQ(std::vector<int>({ 42 }), destroyed);
+}
+
+TEST(GoogleTestRunner, willUnloadObjectFiles_RunsDestructorsOfUnloadedObjectsOnly) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                EngineBuilder().selectTarget(Triple(), "", "",
+                                SmallVector<std::string, 1>()));
+
+  Compiler compiler(*targetMachine.get());
+  auto testerModule = TestModuleFactory.createTesterModule();
+  auto testeeModule = TestModuleFactory.createTesteeModule();
+  auto testerObject = compiler.compileModule(testerModule.get());
+  auto testeeObject = compiler.compileModule(testeeModule.get());
+
+  TestableGoogleTestRunner runner(*targetMachine.get());
+  auto testerResolver = runner.createResolver(testerObject.getBinary());
+  auto testeeResolver = runner.createResolver(testeeObject.getBinary());
+
+  void *testerHandle = reinterpret_cast<void *>(static_cast<uintptr_t>(
+    testerResolver->findSymbol("___dso_handle").getAddress()));
+  void *testeeHandle = reinterpret_cast<void *>(static_cast<uintptr_t>(
+    testeeResolver->findSymbol("___dso_handle").getAddress()));
+  ASSERT_NE(testerHandle, testeeHandle);
+
+  runDestructors();
+  destroyed.clear();
+
+  int objects[] = { 1, 2, 3 };
+  mutang__cxa_atexit(recordDestruction, &objects[0], testeeHandle);
+  mutang__cxa_atexit(recordDestruction, &objects[1], testerHandle);
+  mutang__cxa_atexit(recordDestruction, &objects[2], testeeHandle);
+
+  runner.willUnloadObjectFiles({ testeeObject.getBinary() });
+  ASSERT_EQ(std::vector<int>({ 3, 1 }), destroyed);
+
+  destroyed.clear();
+  runDestructors();
+  ASSERT_EQ(std::vector<int>({ 2 }), destroyed);
+}
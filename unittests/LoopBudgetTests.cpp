@@ -0,0 +1,187 @@
+#include "LoopBudget.h"
+
+#include "ForkProcessSandbox.h"
+#include "SimpleTest/SimpleTest_Test.h"
+#include "SimpleTest/SimpleTestRunner.h"
+#include "Toolchain/Compiler.h"
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include "gtest/gtest.h"
+
+using namespace Mutang;
+using namespace llvm;
+
+/// 'count_to(n)' takes its back-edge n - 1 times, 'count_to(0)' only ends
+/// once the counter wraps around
+static const char *TesteeIR =
+  "define i32 @count_to(i32 %n) {\n"
+  "entry:\n"
+  "  br label %loop\n"
+  "loop:\n"
+  "  %i = phi i32 [ 0, %entry ], [ %next, %loop ]\n"
+  "  %next = add i32 %i, 1\n"
+  "  %done = icmp eq i32 %next, %n\n"
+  "  br i1 %done, label %exit, label %loop\n"
+  "exit:\n"
+  "  ret i32 %next\n"
+  "}\n"
+  ""
+  "define i32 @straight(i32 %a) {\n"
+  "entry:\n"
+  "  %b = add i32 %a, 1\n"
+  "  ret i32 %b\n"
+  "}\n";
+
+static const char *TesterIR =
+  "declare i32 @count_to(i32)\n"
+  ""
+  "define i32 @test_count() {\n"
+  "entry:\n"
+  "  %result = call i32 @count_to(i32 10)\n"
+  "  %passed = icmp eq i32 %result, 10\n"
+  "  %status = zext i1 %passed to i32\n"
+  "  ret i32 %status\n"
+  "}\n"
+  ""
+  "define i32 @test_endless() {\n"
+  "entry:\n"
+  "  %result = call i32 @count_to(i32 0)\n"
+  "  ret i32 1\n"
+  "}\n";
+
+static std::unique_ptr<Module> parseModule(const char *IR, LLVMContext &context) {
+  SMDiagnostic error;
+  auto module = parseAssemblyString(IR, error, context);
+  assert(module && "Can't parse the loop budget fixture");
+  return module;
+}
+
+static std::unique_ptr<TargetMachine> createTargetMachine() {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  return std::unique_ptr<TargetMachine>(
+    EngineBuilder().selectTarget(Triple(), "", "", SmallVector<std::string, 1>()));
+}
+
+TEST(LoopBudget, instrumentCounters_CountsBackEdges) {
+  LLVMContext context;
+  auto tester = parseModule(TesterIR, context);
+  auto testee = parseModule(TesteeIR, context);
+  auto instrumented = CloneModule(testee.get());
+
+  LoopBudget loopBudget(10);
+  loopBudget.instrumentCounters(*testee, *instrumented);
+  loopBudget.allocateCounters();
+  ASSERT_FALSE(verifyModule(*instrumented, &errs()));
+
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  auto testerObject = compiler.compileModule(tester.get());
+  auto testeeObject = compiler.compileModule(instrumented.get());
+
+  SimpleTestRunner runner(*targetMachine);
+  SimpleTestRunner::ObjectFiles program({ testerObject.getBinary(),
+                                          testeeObject.getBinary() });
+  SimpleTest_Test test(tester->getFunction("test_count"));
+  ASSERT_EQ(ExecutionStatus::Passed, runner.runTest(&test, program).Status);
+
+  /// Only 'count_to' has a loop, hence a counter
+  auto counts = loopBudget.collectCounts();
+  ASSERT_EQ(1U, counts.size());
+  ASSERT_EQ(9U, counts[0]);
+
+  loopBudget.resetCounters();
+  ASSERT_EQ(0U, loopBudget.collectCounts()[0]);
+}
+
+TEST(LoopBudget, budgetFor) {
+  LLVMContext context;
+  auto testee = parseModule(TesteeIR, context);
+  auto instrumented = CloneModule(testee.get());
+
+  LoopBudget loopBudget(10);
+  loopBudget.instrumentCounters(*testee, *instrumented);
+
+  Function *countTo = testee->getFunction("count_to");
+  Function *straight = testee->getFunction("straight");
+
+  ASSERT_EQ(5000000U, loopBudget.budgetFor({ 500000 }, countTo));
+
+  /// Short loops and functions without loops get at least the minimum
+  ASSERT_EQ(LoopBudget::MinimumBudget, loopBudget.budgetFor({ 10 }, countTo));
+  ASSERT_EQ(LoopBudget::MinimumBudget, loopBudget.budgetFor({ 500000 }, straight));
+
+  /// Counts of another run, e.g. of an instrumented program without them
+  ASSERT_EQ(LoopBudget::MinimumBudget, loopBudget.budgetFor({}, countTo));
+}
+
+TEST(LoopBudget, instrumentBudget_GuardsBackEdgesOnly) {
+  LLVMContext context;
+  auto testee = parseModule(TesteeIR, context);
+
+  LoopBudget::instrumentBudget(*testee->getFunction("count_to"));
+  LoopBudget::instrumentBudget(*testee->getFunction("straight"));
+  ASSERT_FALSE(verifyModule(*testee, &errs()));
+
+  auto guards = [](Function &function) {
+    int count = 0;
+    for (auto &instruction : instructions(function)) {
+      if (auto call = dyn_cast<CallInst>(&instruction)) {
+        Function *callee = call->getCalledFunction();
+        if (callee && callee->getName() == "mutang_loop_budget_exceeded") {
+          count++;
+        }
+      }
+    }
+    return count;
+  };
+
+  ASSERT_EQ(1, guards(*testee->getFunction("count_to")));
+  ASSERT_EQ(0, guards(*testee->getFunction("straight")));
+}
+
+TEST(LoopBudget, instrumentBudget_EndsEndlessLoop) {
+  LLVMContext context;
+  auto tester = parseModule(TesterIR, context);
+  auto testee = parseModule(TesteeIR, context);
+  LoopBudget::instrumentBudget(*testee->getFunction("count_to"));
+
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine);
+  auto testerObject = compiler.compileModule(tester.get());
+  auto testeeObject = compiler.compileModule(testee.get());
+
+  SimpleTestRunner runner(*targetMachine);
+  SimpleTestRunner::ObjectFiles program({ testerObject.getBinary(),
+                                          testeeObject.getBinary() });
+
+  ForkProcessSandbox sandbox;
+
+  /// Well within the budget
+  SimpleTest_Test count(tester->getFunction("test_count"));
+  LoopBudget::setBudget(100);
+  auto result = sandbox.run([&](ExecutionResult *sharedResult) {
+    *sharedResult = runner.runTest(&count, program);
+  }, 10000);
+  ASSERT_EQ(ExecutionStatus::Passed, result.Status);
+
+  /// Would run for about four billion iterations without the guard
+  SimpleTest_Test endless(tester->getFunction("test_endless"));
+  LoopBudget::setBudget(100);
+  result = sandbox.run([&](ExecutionResult *sharedResult) {
+    *sharedResult = runner.runTest(&endless, program);
+  }, 10000);
+  ASSERT_EQ(ExecutionStatus::LoopBudgetExceeded, result.Status);
+}
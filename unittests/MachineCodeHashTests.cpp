@@ -0,0 +1,83 @@
+#include "Toolchain/Compiler.h"
+#include "Toolchain/MachineCodeHash.h"
+#include "MutangModule.h"
+#include "MutationPoint.h"
+#include "MutationOperators/AddMutationOperator.h"
+#include "TestModuleFactory.h"
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/TargetSelect.h"
+
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace Mutang;
+
+static TestModuleFactory TestModuleFactory;
+
+static std::unique_ptr<TargetMachine> createTargetMachine() {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  return std::unique_ptr<TargetMachine>(
+           EngineBuilder().selectTarget(Triple(), "", "",
+                                        SmallVector<std::string, 1>()));
+}
+
+TEST(MachineCodeHash, hashFunctionCode_FoldedMutantMatchesOriginal) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine.get());
+
+  auto mutangModule = make_unique<MutangModule>(TestModuleFactory.createEquivalentMutantsModule(), "");
+  Module &module = *mutangModule->getModule();
+  Function *addZero = module.getFunction("add_zero");
+
+  AddMutationOperator mutationOperator;
+  MutationPoint point(&mutationOperator,
+                      MutationPointAddress(0, 0, 0),
+                      &*addZero->getEntryBlock().begin(),
+                      mutangModule.get());
+
+  auto mutant = point.applyMutation(compiler);
+  auto original = compiler.compileModule(*mutangModule);
+
+  std::string originalHash = hashFunctionCode(*original.getBinary(), "add_zero");
+  ASSERT_NE("", originalHash);
+  ASSERT_EQ(originalHash, hashFunctionCode(*mutant.getBinary(), "add_zero"));
+}
+
+TEST(MachineCodeHash, hashFunctionCode_MutantDiffersFromOriginal) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine.get());
+
+  auto mutangModule = make_unique<MutangModule>(TestModuleFactory.createEquivalentMutantsModule(), "");
+  Module &module = *mutangModule->getModule();
+  Function *sum = module.getFunction("sum");
+
+  AddMutationOperator mutationOperator;
+  MutationPoint point(&mutationOperator,
+                      MutationPointAddress(1, 0, 0),
+                      &*sum->getEntryBlock().begin(),
+                      mutangModule.get());
+
+  auto mutant = point.applyMutation(compiler);
+  auto original = compiler.compileModule(*mutangModule);
+
+  ASSERT_NE(hashFunctionCode(*original.getBinary(), "sum"),
+            hashFunctionCode(*mutant.getBinary(), "sum"));
+  ASSERT_EQ("", hashFunctionCode(*original.getBinary(), "not_there"));
+}
+
+TEST(MachineCodeHash, hashFunctionCode_RelocationAddends) {
+  auto targetMachine = createTargetMachine();
+  Compiler compiler(*targetMachine.get());
+
+  auto module = TestModuleFactory.createRelocationAddendsModule();
+  auto object = compiler.compileModule(module.get());
+
+  std::string firstHash = hashFunctionCode(*object.getBinary(), "first");
+  ASSERT_NE("", firstHash);
+  ASSERT_NE(firstHash, hashFunctionCode(*object.getBinary(), "second"));
+}
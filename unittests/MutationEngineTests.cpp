@@ -66,7 +66,7 @@ TEST(MutationEngine, SimpleTest_AddOperator_applyMutation) {
 
   auto &Test = *(Tests.begin());
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(2U, Testees.size());
 
@@ -116,7 +116,7 @@ TEST(MutationEngine, SimpleTest_NegateConditionOperator_applyMutation) {
 
   auto &Test = *(Tests.begin());
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(2U, Testees.size());
 
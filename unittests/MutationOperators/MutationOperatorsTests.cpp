@@ -1,5 +1,11 @@
 #include "MutationOperators/MutationOperator.h"
 #include "MutationOperators/AddMutationOperator.h"
+#include "MutationOperators/MutationOperatorRegistry.h"
+#include "MutationOperators/MutationPointScanner.h"
+#include "ConfigParser.h"
+#include "Context.h"
+#include "MutationPoint.h"
+#include "TestModuleFactory.h"
 
 #include "llvm/IR/Argument.h"
 #include "llvm/IR/BasicBlock.h"
@@ -19,6 +25,7 @@ using namespace Mutang;
 using namespace llvm;
 
 static LLVMContext Ctx;
+static TestModuleFactory TestModuleFactory;
 
 TEST(MutationOperators, AddMutationOperator) {
   ConstantInt *A = ConstantInt::get(Type::getInt32Ty(Ctx), 42, 0);
@@ -38,3 +45,52 @@ TEST(MutationOperators, AddMutationOperator) {
   std::unique_ptr<BinaryOperator> FSub(BinaryOperator::CreateFSub(FA, FB));
   EXPECT_EQ(false, mutationOperator.canBeApplied(*FSub));
 }
+
+TEST(MutationOperators, Registry_AllOperatorsByDefault) {
+  MutationOperatorRegistry registry;
+
+  auto operators = registry.createOperators({});
+
+  ASSERT_EQ(registry.getIdentifiers().size(), operators.size());
+  ASSERT_EQ(3U, operators.size());
+}
+
+TEST(MutationOperators, Registry_SelectedOperators) {
+  MutationOperatorRegistry registry;
+
+  auto operators = registry.createOperators({ "negate_mutation_operator",
+                                              "add_mutation_operator" });
+
+  ASSERT_EQ(2U, operators.size());
+  ASSERT_EQ("negate_mutation_operator", operators[0]->uniqueID());
+  ASSERT_EQ("add_mutation_operator", operators[1]->uniqueID());
+}
+
+TEST(MutationOperators, Registry_RefusesUnknownOperator) {
+  MutationOperatorRegistry registry;
+
+  ASSERT_EXIT(registry.createOperators({ "negate_mutation_operator",
+                                         "no_such_operator" }),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+}
+
+TEST(MutationOperators, Scanner_DispatchesByOpcode) {
+  auto mutangModule = make_unique<MutangModule>(TestModuleFactory.createTesteeModule(), "");
+  Function *function = mutangModule->getModule()->getFunction("count_letters");
+
+  Context context;
+  context.addModule(std::move(mutangModule));
+
+  MutationOperatorRegistry registry;
+  auto operators = registry.createOperators({});
+  MutationPointScanner scanner(operators);
+
+  NullMutationOperatorFilter filter;
+  auto mutationPoints = scanner.scan(context, *function, filter);
+
+  /// The comparison is implicit and strchr does not return void,
+  /// only the increment of the counter can be mutated
+  ASSERT_EQ(1U, mutationPoints.size());
+  ASSERT_EQ("add_mutation_operator", mutationPoints[0]->getOperator()->uniqueID());
+  ASSERT_EQ("0_2_1", mutationPoints[0]->getAddress().getIdentifier());
+}
@@ -1,6 +1,7 @@
 
 #include "MutationOperators/MutationOperator.h"
 #include "MutationOperators/MutationOperatorFilter.h"
+#include "MutationOperators/MutationPointScanner.h"
 #include "MutationOperators/NegateConditionMutationOperator.h"
 #include "Context.h"
 
@@ -72,7 +73,7 @@ TEST(NegateConditionMutationOperator, negatedCmpInstPredicate) {
   EXPECT_EQ(NegateConditionMutationOperator::negatedCmpInstPredicate(CmpInst::ICMP_SLT), CmpInst::ICMP_SGE);
 }
 
-TEST(NegateConditionMutationOperator, getMutationPoints_no_filter) {
+TEST(NegateConditionMutationOperator, scan_no_filter) {
   TestModuleFactory factory;
   auto llvmModule = factory.APInt_9a3c2a89c9f30b6c2ab9a1afce2b65d6_213_0_17_negate_mutation_operatorModule();
   assert(llvmModule);
@@ -84,14 +85,16 @@ TEST(NegateConditionMutationOperator, getMutationPoints_no_filter) {
   Context context;
   context.addModule(std::move(module));
 
-  NegateConditionMutationOperator mutationOperator;
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+  MutationPointScanner scanner(mutationOperators);
   NullMutationOperatorFilter filter;
 
-  auto mutationPoints = mutationOperator.getMutationPoints(context, function, filter);
+  auto mutationPoints = scanner.scan(context, *function, filter);
   EXPECT_EQ(1U, mutationPoints.size());
 }
 
-TEST(NegateConditionMutationOperator, getMutationPoints_filter_to_bool_converion) {
+TEST(NegateConditionMutationOperator, scan_filter_to_bool_converion) {
   TestModuleFactory factory;
   auto llvmModule = factory.APFloat_019fc57b8bd190d33389137abbe7145e_214_2_7_negate_mutation_operatorModule();
   assert(llvmModule);
@@ -103,14 +106,16 @@ TEST(NegateConditionMutationOperator, getMutationPoints_filter_to_bool_converion
   Context context;
   context.addModule(std::move(module));
 
-  NegateConditionMutationOperator mutationOperator;
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+  MutationPointScanner scanner(mutationOperators);
   NullMutationOperatorFilter filter;
 
-  auto mutationPoints = mutationOperator.getMutationPoints(context, function, filter);
+  auto mutationPoints = scanner.scan(context, *function, filter);
   EXPECT_EQ(0U, mutationPoints.size());
 }
 
-TEST(NegateConditionMutationOperator, getMutationPoints_filter_is_null) {
+TEST(NegateConditionMutationOperator, scan_filter_is_null) {
   TestModuleFactory factory;
   auto llvmModule = factory.APFloat_019fc57b8bd190d33389137abbe7145e_5_1_3_negate_mutation_operatorModule();
   assert(llvmModule);
@@ -122,9 +127,11 @@ TEST(NegateConditionMutationOperator, getMutationPoints_filter_is_null) {
   Context context;
   context.addModule(std::move(module));
 
-  NegateConditionMutationOperator mutationOperator;
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<NegateConditionMutationOperator>());
+  MutationPointScanner scanner(mutationOperators);
   NullMutationOperatorFilter filter;
 
-  auto mutationPoints = mutationOperator.getMutationPoints(context, function, filter);
+  auto mutationPoints = scanner.scan(context, *function, filter);
   EXPECT_EQ(0U, mutationPoints.size());
 }
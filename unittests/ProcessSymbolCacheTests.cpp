@@ -0,0 +1,50 @@
+#include "Toolchain/ProcessSymbolCache.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+TEST(ProcessSymbolCache, findSymbol_CountsHitsAndMisses) {
+  ProcessSymbolCache &cache = ProcessSymbolCache::shared();
+  cache.resetCounters();
+
+  auto first = cache.findSymbol("mutang_process_symbol_cache_test_unknown");
+  ASSERT_FALSE(first);
+  ASSERT_EQ(0U, cache.getHits());
+  ASSERT_EQ(1U, cache.getMisses());
+
+  auto second = cache.findSymbol("mutang_process_symbol_cache_test_unknown");
+  ASSERT_FALSE(second);
+  ASSERT_EQ(1U, cache.getHits());
+  ASSERT_EQ(1U, cache.getMisses());
+}
+
+TEST(ProcessSymbolCache, findSymbol_ResolvesProcessSymbols) {
+  ProcessSymbolCache &cache = ProcessSymbolCache::shared();
+
+  auto first = cache.findSymbol("malloc");
+  ASSERT_TRUE(bool(first));
+
+  auto second = cache.findSymbol("malloc");
+  ASSERT_EQ(first.getAddress(), second.getAddress());
+}
+
+TEST(ProcessSymbolCache, counters_SharedWithForkedChildren) {
+  ProcessSymbolCache &cache = ProcessSymbolCache::shared();
+  cache.resetCounters();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    cache.findSymbol("mutang_process_symbol_cache_test_child");
+    exit(0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+
+  ASSERT_EQ(1U, cache.getMisses());
+}
@@ -4,11 +4,13 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstring>
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include <sqlite3.h>
+#include <unistd.h>
 
 using namespace Mutang;
 using namespace llvm;
@@ -43,7 +45,7 @@ TEST(SQLiteReporter, integrationTest) {
   results.push_back(std::move(testResult));
 
   /// In this test we are not interested in testees.
-  std::vector<std::unique_ptr<Testee>> testees;
+  std::vector<Testee *> testees;
 
   std::unique_ptr<Result> result = make_unique<Result>(std::move(results),
                                                        std::move(testees));
@@ -99,6 +101,48 @@ TEST(SQLiteReporter, integrationTest) {
   sqlite3_close(database);
 }
 
+TEST(SQLiteReporter, schemaVersionAndIndexes) {
+  SQLiteReporter reporter;
+
+  std::vector<std::unique_ptr<TestResult>> results;
+  std::vector<Testee *> testees;
+  std::unique_ptr<Result> result = make_unique<Result>(std::move(results),
+                                                       std::move(testees));
+
+  /// The database is named after the current time, so another test of this
+  /// suite may have created it within the same second.
+  unlink(reporter.getDatabasePath().c_str());
+  reporter.reportResults(result);
+
+  sqlite3 *database;
+  sqlite3_open(reporter.getDatabasePath().c_str(), &database);
+
+  std::string versionQuery = "SELECT version FROM schema_version";
+  sqlite3_stmt *versionStmt;
+  sqlite3_prepare(database, versionQuery.c_str(), versionQuery.size(), &versionStmt, NULL);
+  ASSERT_EQ(SQLITE_ROW, sqlite3_step(versionStmt));
+  ASSERT_LT(0, sqlite3_column_int(versionStmt, 0));
+  sqlite3_finalize(versionStmt);
+
+  std::string indexQuery = "SELECT name FROM sqlite_master WHERE type = 'index'"
+                           " AND tbl_name = 'mutation_result'";
+  sqlite3_stmt *indexStmt;
+  sqlite3_prepare(database, indexQuery.c_str(), indexQuery.size(), &indexStmt, NULL);
+
+  std::vector<std::string> indexes;
+  while (sqlite3_step(indexStmt) == SQLITE_ROW) {
+    indexes.push_back((const char *)sqlite3_column_text(indexStmt, 0));
+  }
+  sqlite3_finalize(indexStmt);
+
+  ASSERT_NE(indexes.end(), std::find(indexes.begin(), indexes.end(),
+                                     "mutation_result_test_id_index"));
+  ASSERT_NE(indexes.end(), std::find(indexes.begin(), indexes.end(),
+                                     "mutation_result_mutation_point_id_index"));
+
+  sqlite3_close(database);
+}
+
 TEST(SQLiteReporter, callerPathToString) {
   std::vector<std::string> callerPath;
 
@@ -112,3 +156,77 @@ TEST(SQLiteReporter, callerPathToString) {
   ASSERT_EQ(reporter.getCallerPathAsString(callerPath),
             expectedCallerPathString);
 }
+
+static int countRows(sqlite3 *database, const char *query) {
+  sqlite3_stmt *statement;
+  sqlite3_prepare(database, query, -1, &statement, NULL);
+  int count = -1;
+  if (sqlite3_step(statement) == SQLITE_ROW) {
+    count = sqlite3_column_int(statement, 0);
+  }
+  sqlite3_finalize(statement);
+  return count;
+}
+
+TEST(SQLiteReporter, mergeDatabases) {
+  SQLiteReporter reporter;
+  std::string databasePath = reporter.getDatabasePath();
+
+  std::vector<std::string> shards;
+  for (int shard = 0; shard < 2; shard++) {
+    std::vector<std::unique_ptr<TestResult>> results;
+    std::vector<Testee *> testees;
+    std::unique_ptr<Result> result = make_unique<Result>(std::move(results),
+                                                         std::move(testees));
+    unlink(databasePath.c_str());
+    reporter.reportResults(result);
+
+    /// Both shards run the test, each runs one of the mutants
+    std::string pointID = "mutant" + std::to_string(shard);
+    std::string rows =
+      "INSERT INTO execution_result (status, duration, stdout, stderr)"
+      "  VALUES (2, 10, '', '');"
+      "INSERT INTO test (test_name, execution_result_id, testees_hash)"
+      "  VALUES ('test_sum', 1, 'testees');"
+      "INSERT INTO execution_result (status, duration, stdout, stderr, max_rss)"
+      "  VALUES (1, 20, '', '', 4096);"
+      "INSERT INTO mutation_point (unique_id, stable_id)"
+      "  VALUES ('" + pointID + "', '" + pointID + "');"
+      "INSERT INTO mutation_result VALUES (2, 1, 1, 1);";
+
+    sqlite3 *database;
+    sqlite3_open(databasePath.c_str(), &database);
+    sqlite3_exec(database, rows.c_str(), nullptr, nullptr, nullptr);
+    sqlite3_close(database);
+
+    std::string shardPath = databasePath + ".shard" + std::to_string(shard);
+    rename(databasePath.c_str(), shardPath.c_str());
+    shards.push_back(shardPath);
+  }
+
+  /// A shard given twice adds nothing
+  unlink(databasePath.c_str());
+  reporter.mergeDatabases({ shards[0], shards[1], shards[0] });
+
+  sqlite3 *database;
+  sqlite3_open(databasePath.c_str(), &database);
+
+  ASSERT_EQ(1, countRows(database, "SELECT COUNT(*) FROM test"));
+  ASSERT_EQ(2, countRows(database, "SELECT COUNT(*) FROM mutation_point"));
+  ASSERT_EQ(2, countRows(database, "SELECT COUNT(*) FROM mutation_result"));
+  ASSERT_EQ(3, countRows(database, "SELECT COUNT(*) FROM execution_result"));
+  ASSERT_EQ(2, countRows(database,
+                         "SELECT COUNT(*) FROM mutation_result"
+                         " JOIN execution_result ON execution_result.rowid = mutation_result.execution_result_id"
+                         " JOIN test ON test.id = mutation_result.test_id"
+                         " WHERE execution_result.status = 1 AND test.test_name = 'test_sum'"));
+  ASSERT_EQ(2, countRows(database,
+                         "SELECT COUNT(*) FROM execution_result WHERE max_rss = 4096"));
+
+  sqlite3_close(database);
+
+  for (auto &shard : shards) {
+    unlink(shard.c_str());
+  }
+  unlink(databasePath.c_str());
+}
@@ -0,0 +1,55 @@
+#include "ShardPlanner.h"
+
+#include "ConfigParser.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace Mutang;
+
+TEST(ShardPlanner, assign_EveryJobToExactlyOneShard) {
+  const int shardCount = 3;
+  std::vector<ShardPlanner> shards;
+  for (int i = 0; i < shardCount; i++) {
+    shards.emplace_back(i, shardCount);
+  }
+
+  for (int job = 0; job < 100; job++) {
+    int owners = 0;
+    for (auto &shard : shards) {
+      if (shard.isOwnJob("job" + std::to_string(job), job % 7 + 1)) {
+        owners++;
+      }
+    }
+    ASSERT_EQ(1, owners);
+  }
+}
+
+TEST(ShardPlanner, assign_SameJobSameShard) {
+  ShardPlanner planner(0, 4);
+
+  int shard = planner.assign("test_sum\nmutant", 10);
+  planner.assign("test_sum\nanother_mutant", 10);
+
+  ASSERT_EQ(shard, planner.assign("test_sum\nmutant", 1000));
+}
+
+TEST(ShardPlanner, assign_BalancesCost) {
+  ShardPlanner planner(0, 2);
+
+  /// One expensive job outweighs several cheap ones
+  int expensive = planner.assign("expensive", 100);
+  for (int job = 0; job < 10; job++) {
+    ASSERT_NE(expensive, planner.assign("cheap" + std::to_string(job), 1));
+  }
+}
+
+TEST(ShardPlanner, RefusesInvalidShard) {
+  ASSERT_EXIT(ShardPlanner(5, 2),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+  ASSERT_EXIT(ShardPlanner(-1, 2),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+  ASSERT_EXIT(ShardPlanner(0, 0),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+}
@@ -58,7 +58,7 @@ TEST(SimpleTestFinder, FindTestee) {
 
   auto &Test = *(Tests.begin());
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(2U, Testees.size());
 
@@ -86,7 +86,7 @@ TEST(SimpleTestFinder, FindMutationPoints_AddMutationOperator) {
 
   auto &Test = *Tests.begin();
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(2U, Testees.size());
 
@@ -128,7 +128,7 @@ TEST(SimpleTestFinder, FindMutationPoints_NegateConditionMutationOperator) {
 
   auto &Test = *Tests.begin();
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(2U, Testees.size());
 
@@ -170,7 +170,7 @@ TEST(SimpleTestFinder, FindMutationPoints_RemoteVoidFunctionMutationOperator) {
 
   auto &Test = *Tests.begin();
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_EQ(3U, Testees.size());
 
@@ -215,15 +215,15 @@ TEST(SimpleTestFinder, FindTestees_TesteePathMemorization) {
 
   SimpleTest_Test *test = dyn_cast<SimpleTest_Test>((*Tests.begin()).get());
 
-  std::vector<std::unique_ptr<Testee>> testees = Finder.findTestees(test, Ctx, 4);
+  std::vector<Testee *> testees = Finder.findTestees(test, Ctx, 4);
 
   ASSERT_EQ(5U, testees.size());
 
-  Testee *testee1 = testees[0].get();
-  Testee *testee2 = testees[1].get();
-  Testee *testee3 = testees[2].get();
-  Testee *testee4 = testees[3].get();
-  Testee *testee5 = testees[4].get();
+  Testee *testee1 = testees[0];
+  Testee *testee2 = testees[1];
+  Testee *testee3 = testees[2];
+  Testee *testee4 = testees[3];
+  Testee *testee5 = testees[4];
 
   Function *testeeFunction1 = testee1->getTesteeFunction();
   Function *testeeFunction2 = testee2->getTesteeFunction();
@@ -0,0 +1,63 @@
+#include "SyntheticProject.h"
+
+#include "SimpleTest/SimpleTest_Test.h"
+#include "SimpleTest/SimpleTestRunner.h"
+#include "TestResult.h"
+#include "Toolchain/Compiler.h"
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/TargetSelect.h"
+
+#include "gtest/gtest.h"
+
+using namespace Mutang;
+using namespace llvm;
+
+TEST(SyntheticProject, SimpleTestModules_AllTestsPass) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                EngineBuilder().selectTarget(Triple(), "", "",
+                                SmallVector<std::string, 1>()));
+
+  LLVMContext context;
+  SyntheticProject project({ 2, 3, 2, 2 });
+  auto modules = project.createSimpleTestModules(context);
+
+  Compiler compiler(*targetMachine.get());
+  SimpleTestRunner::ObjectFiles objectFiles;
+  SimpleTestRunner::OwnedObjectFiles ownedObjectFiles;
+  for (auto &module : modules) {
+    ASSERT_FALSE(verifyModule(*module, &errs()));
+
+    auto objectFile = compiler.compileModule(module.get());
+    objectFiles.push_back(objectFile.getBinary());
+    ownedObjectFiles.push_back(std::move(objectFile));
+  }
+
+  SimpleTestRunner runner(*targetMachine.get());
+
+  /// Every test compares against the value computed by the generator,
+  /// the JIT-ed code must agree with it
+  int tests = 0;
+  for (auto &module : modules) {
+    for (auto &function : *module) {
+      if (function.isDeclaration() || !function.getName().startswith("test_")) {
+        continue;
+      }
+
+      SimpleTest_Test test(&function);
+      ASSERT_EQ(ExecutionStatus::Passed, runner.runTest(&test, objectFiles).Status)
+        << function.getName().str();
+      tests++;
+    }
+  }
+
+  /// One test per function of the first level of each module
+  ASSERT_EQ(4, tests);
+}
@@ -377,3 +377,201 @@ std::unique_ptr<Module> TestModuleFactory::APFloat_019fc57b8bd190d33389137abbe71
 
   return module;
 }
+
+std::unique_ptr<Module> TestModuleFactory::createEquivalentMutantsModule() {
+  auto module = parseIR("define i32 @add_zero(i32 %a) {\n"
+                        "entry:\n"
+                        "  %add = add i32 %a, 0\n"
+                        "  ret i32 %add\n"
+                        "}\n"
+                        ""
+                        "define i32 @sum(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %add = add i32 %a, %b\n"
+                        "  ret i32 %add\n"
+                        "}\n");
+
+  module->setModuleIdentifier("equivalent_mutants");
+
+  return module;
+}
+
+/// Both functions compile to the same instructions, only the addends of
+/// their relocations differ
+std::unique_ptr<Module> TestModuleFactory::createRelocationAddendsModule() {
+  auto module = parseIR("@pair = internal global [2 x i32] [i32 1, i32 2]\n"
+                        ""
+                        "define i32* @first() {\n"
+                        "entry:\n"
+                        "  ret i32* getelementptr ([2 x i32], [2 x i32]* @pair, i64 0, i64 0)\n"
+                        "}\n"
+                        ""
+                        "define i32* @second() {\n"
+                        "entry:\n"
+                        "  ret i32* getelementptr ([2 x i32], [2 x i32]* @pair, i64 0, i64 1)\n"
+                        "}\n");
+
+  module->setModuleIdentifier("relocation_addends");
+
+  return module;
+}
+
+/// Three tests reaching the same two mutants: test_far through a wrapper,
+/// test_weak with inputs that cannot tell add from sub, and test_strong
+/// with inputs that can
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_MutantCentric_Tester_Module() {
+  auto module = parseIR("declare i32 @first(i32, i32)\n"
+                        "declare i32 @second(i32, i32)\n"
+                        "declare i32 @wrapped_first(i32, i32)\n"
+                        ""
+                        "define i32 @test_far() {\n"
+                        "entry:\n"
+                        "  %result = call i32 @wrapped_first(i32 0, i32 0)\n"
+                        "  %passed = icmp eq i32 %result, 0\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n"
+                        ""
+                        "define i32 @test_weak() {\n"
+                        "entry:\n"
+                        "  %first = call i32 @first(i32 0, i32 0)\n"
+                        "  %second = call i32 @second(i32 0, i32 0)\n"
+                        "  %both = or i32 %first, %second\n"
+                        "  %passed = icmp eq i32 %both, 0\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n"
+                        ""
+                        "define i32 @test_strong() {\n"
+                        "entry:\n"
+                        "  %first = call i32 @first(i32 2, i32 3)\n"
+                        "  %second = call i32 @second(i32 2, i32 3)\n"
+                        "  %first_passed = icmp eq i32 %first, 5\n"
+                        "  %second_passed = icmp eq i32 %second, 5\n"
+                        "  %passed = and i1 %first_passed, %second_passed\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n");
+
+  module->setModuleIdentifier("mutant_centric_tester");
+
+  return module;
+}
+
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_MutantCentric_Testee_Module() {
+  auto module = parseIR("define i32 @first(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %add = add i32 %a, %b\n"
+                        "  ret i32 %add\n"
+                        "}\n"
+                        ""
+                        "define i32 @second(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %add = add i32 %a, %b\n"
+                        "  ret i32 %add\n"
+                        "}\n"
+                        ""
+                        "define i32 @wrapped_first(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %result = call i32 @first(i32 %a, i32 %b)\n"
+                        "  ret i32 %result\n"
+                        "}\n");
+
+  module->setModuleIdentifier("mutant_centric_testee");
+
+  return module;
+}
+
+/// The test only takes the 'positive' branch of 'normalize'
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_CoveragePruning_Tester_Module() {
+  auto module = parseIR("declare i32 @normalize(i32)\n"
+                        ""
+                        "define i32 @test_normalize() {\n"
+                        "entry:\n"
+                        "  %result = call i32 @normalize(i32 1)\n"
+                        "  %passed = icmp eq i32 %result, 2\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n");
+
+  module->setModuleIdentifier("coverage_pruning_tester");
+
+  return module;
+}
+
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_CoveragePruning_Testee_Module() {
+  auto module = parseIR("define i32 @normalize(i32 %a) {\n"
+                        "entry:\n"
+                        "  %isNegative = icmp slt i32 %a, 0\n"
+                        "  br i1 %isNegative, label %negative, label %positive\n"
+                        ""
+                        "negative:\n"
+                        "  %shifted = add i32 %a, 100\n"
+                        "  ret i32 %shifted\n"
+                        ""
+                        "positive:\n"
+                        "  %incremented = add i32 %a, 1\n"
+                        "  ret i32 %incremented\n"
+                        "}\n");
+
+  module->setModuleIdentifier("coverage_pruning_testee");
+
+  return module;
+}
+
+/// 'test_fh' calls 'f' without looking at its result
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_TrivialCompilerEquivalence_Tester_Module() {
+  auto module = parseIR("declare i32 @f(i32, i32)\n"
+                        "declare i32 @g(i32, i32)\n"
+                        "declare i32 @h(i32, i32)\n"
+                        ""
+                        "define i32 @test_fh() {\n"
+                        "entry:\n"
+                        "  %ignored = call i32 @f(i32 2, i32 3)\n"
+                        "  %result = call i32 @h(i32 3, i32 2)\n"
+                        "  %passed = icmp eq i32 %result, 2\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n"
+                        ""
+                        "define i32 @test_g() {\n"
+                        "entry:\n"
+                        "  %result = call i32 @g(i32 2, i32 3)\n"
+                        "  %passed = icmp eq i32 %result, 6\n"
+                        "  %status = zext i1 %passed to i32\n"
+                        "  ret i32 %status\n"
+                        "}\n");
+
+  module->setModuleIdentifier("trivial_compiler_equivalence_tester");
+
+  return module;
+}
+
+/// 'f' and 'h' compile to the same code, so do their mutants. The first
+/// mutant of 'g' compiles to the same code as 'f'.
+std::unique_ptr<Module> TestModuleFactory::create_SimpleTest_TrivialCompilerEquivalence_Testee_Module() {
+  auto module = parseIR("define i32 @f(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %sub = sub i32 %a, %b\n"
+                        "  %add = add i32 %sub, 1\n"
+                        "  ret i32 %add\n"
+                        "}\n"
+                        ""
+                        "define i32 @g(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %sum = add i32 %a, %b\n"
+                        "  %add = add i32 %sum, 1\n"
+                        "  ret i32 %add\n"
+                        "}\n"
+                        ""
+                        "define i32 @h(i32 %a, i32 %b) {\n"
+                        "entry:\n"
+                        "  %sub = sub i32 %a, %b\n"
+                        "  %add = add i32 %sub, 1\n"
+                        "  ret i32 %add\n"
+                        "}\n");
+
+  module->setModuleIdentifier("trivial_compiler_equivalence_testee");
+
+  return module;
+}
@@ -31,6 +31,18 @@ public:
   std::unique_ptr<Module> createGoogleTestTesterModule();
   std::unique_ptr<Module> createGoogleTestTesteeModule();
 
+  std::unique_ptr<Module> createEquivalentMutantsModule();
+  std::unique_ptr<Module> createRelocationAddendsModule();
+
+  std::unique_ptr<Module> create_SimpleTest_MutantCentric_Tester_Module();
+  std::unique_ptr<Module> create_SimpleTest_MutantCentric_Testee_Module();
+
+  std::unique_ptr<Module> create_SimpleTest_CoveragePruning_Tester_Module();
+  std::unique_ptr<Module> create_SimpleTest_CoveragePruning_Testee_Module();
+
+  std::unique_ptr<Module> create_SimpleTest_TrivialCompilerEquivalence_Tester_Module();
+  std::unique_ptr<Module> create_SimpleTest_TrivialCompilerEquivalence_Testee_Module();
+
   std::unique_ptr<Module> APInt_9a3c2a89c9f30b6c2ab9a1afce2b65d6_213_0_17_negate_mutation_operatorModule();
   std::unique_ptr<Module> APFloat_019fc57b8bd190d33389137abbe7145e_214_2_7_negate_mutation_operatorModule();
   std::unique_ptr<Module> APFloat_019fc57b8bd190d33389137abbe7145e_5_1_3_negate_mutation_operatorModule();
@@ -82,7 +82,7 @@ TEST(SimpleTestRunner, runTest) {
   /// afterwards we apply single mutation and run test again
   /// expecting it to fail
 
-  std::vector<std::unique_ptr<Testee>> Testees = testFinder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = testFinder.findTestees(Test.get(), Ctx, 4);
 
   ASSERT_NE(0U, Testees.size());
   Function *Testee = Testees[1]->getTesteeFunction();
@@ -113,6 +113,70 @@ TEST(SimpleTestRunner, runTest) {
   ObjectFiles.erase(ObjectFiles.begin(), ObjectFiles.end());
 }
 
+TEST(SimpleTestRunner, runTestSwapsMutatedModule) {
+  InitializeNativeTarget();
+  InitializeNativeTargetAsmPrinter();
+  InitializeNativeTargetAsmParser();
+
+  std::unique_ptr<TargetMachine> targetMachine(
+                                EngineBuilder().selectTarget(Triple(), "", "",
+                                SmallVector<std::string, 1>()));
+
+  Compiler compiler(*targetMachine.get());
+  Context Ctx;
+  SimpleTestRunner Runner(*targetMachine.get());
+  SimpleTestRunner::OwnedObjectFiles OwnedObjectFiles;
+
+  auto OwnedModuleWithTests   = TestModuleFactory.createTesterModule();
+  auto OwnedModuleWithTestees = TestModuleFactory.createTesteeModule();
+
+  Module *ModuleWithTests   = OwnedModuleWithTests.get();
+  Module *ModuleWithTestees = OwnedModuleWithTestees.get();
+
+  Ctx.addModule(make_unique<MutangModule>(std::move(OwnedModuleWithTests), ""));
+  Ctx.addModule(make_unique<MutangModule>(std::move(OwnedModuleWithTestees), ""));
+
+  std::vector<std::unique_ptr<MutationOperator>> mutationOperators;
+  mutationOperators.emplace_back(make_unique<AddMutationOperator>());
+
+  SimpleTestFinder testFinder(std::move(mutationOperators));
+
+  auto Tests = testFinder.findTests(Ctx);
+  ASSERT_NE(0U, Tests.size());
+  auto &Test = *(Tests.begin());
+
+  OwnedObjectFiles.push_back(compiler.compileModule(ModuleWithTests));
+  OwnedObjectFiles.push_back(compiler.compileModule(ModuleWithTestees));
+
+  auto TesterObject  = OwnedObjectFiles[0].getBinary();
+  auto TesteeObject  = OwnedObjectFiles[1].getBinary();
+
+  SimpleTestRunner::ObjectFiles Program({ TesterObject, TesteeObject });
+  Runner.loadProgram(Program);
+
+  ASSERT_EQ(ExecutionStatus::Passed, Runner.runTest(Test.get(), Program).Status);
+  ASSERT_EQ(ExecutionStatus::Passed, Runner.runTest(Test.get(), Program).Status);
+
+  std::vector<Testee *> Testees = testFinder.findTestees(Test.get(), Ctx, 4);
+  ASSERT_NE(0U, Testees.size());
+  Function *Testee = Testees[1]->getTesteeFunction();
+
+  std::vector<MutationPoint *> MutationPoints = testFinder.findMutationPoints(Ctx, *Testee);
+  ASSERT_NE(0U, MutationPoints.size());
+
+  MutationEngine Engine;
+  Engine.applyMutation(Testee->getParent(), **MutationPoints.begin());
+
+  OwnedObjectFiles.push_back(compiler.compileModule(ModuleWithTestees));
+  auto MutantObject = OwnedObjectFiles[2].getBinary();
+
+  /// Only the module with testees is replaced, the tester stays linked
+  SimpleTestRunner::ObjectFiles MutatedProgram({ TesterObject, MutantObject });
+  ASSERT_EQ(ExecutionStatus::Failed, Runner.runTest(Test.get(), MutatedProgram).Status);
+
+  ASSERT_EQ(ExecutionStatus::Passed, Runner.runTest(Test.get(), Program).Status);
+}
+
 TEST(SimpleTestRunner, runTestUsingLibC) {
   InitializeNativeTarget();
   InitializeNativeTargetAsmPrinter();
@@ -167,7 +231,7 @@ TEST(SimpleTestRunner, runTestUsingLibC) {
   /// afterwards we apply single mutation and run test again
   /// expecting it to fail
 
-  std::vector<std::unique_ptr<Testee>> Testees = Finder.findTestees(Test.get(), Ctx, 4);
+  std::vector<Testee *> Testees = Finder.findTestees(Test.get(), Ctx, 4);
   ASSERT_NE(0U, Testees.size());
   Function *Testee = Testees[1]->getTesteeFunction();
 
@@ -0,0 +1,51 @@
+#include "TimeoutPolicy.h"
+
+#include "ConfigParser.h"
+
+#include "gtest/gtest.h"
+
+using namespace Mutang;
+
+TEST(TimeoutPolicy, timeoutFor_AppliesMultiplierToMedian) {
+  TimeoutPolicy policy(10, 1, 100000);
+
+  /// 100ms, no variance
+  std::vector<long long> runningTimes({ 100000, 100000, 100000 });
+
+  ASSERT_EQ(1000, policy.timeoutFor(runningTimes));
+}
+
+TEST(TimeoutPolicy, timeoutFor_IgnoresSingleOutlierInMedian) {
+  TimeoutPolicy policy(1, 1, 100000);
+
+  std::vector<long long> stable({ 10000, 10000, 10000 });
+  std::vector<long long> noisy({ 10000, 10000, 40000 });
+
+  /// Median is the same, but the noisy test gets some slack
+  ASSERT_EQ(10, policy.timeoutFor(stable));
+  ASSERT_LT(10, policy.timeoutFor(noisy));
+  ASSERT_GT(50, policy.timeoutFor(noisy));
+}
+
+TEST(TimeoutPolicy, timeoutFor_RespectsFloor) {
+  TimeoutPolicy policy(10, 300, 60000);
+
+  /// Sub-millisecond test
+  std::vector<long long> runningTimes({ 15 });
+
+  ASSERT_EQ(300, policy.timeoutFor(runningTimes));
+}
+
+TEST(TimeoutPolicy, timeoutFor_RespectsCeiling) {
+  TimeoutPolicy policy(10, 300, 60000);
+
+  /// 20 seconds
+  std::vector<long long> runningTimes({ 20000000 });
+
+  ASSERT_EQ(60000, policy.timeoutFor(runningTimes));
+}
+
+TEST(TimeoutPolicy, RefusesFloorAboveCeiling) {
+  ASSERT_EXIT(TimeoutPolicy(10, 1000, 500),
+              ::testing::ExitedWithCode(ConfigurationErrorExitCode), "");
+}
@@ -0,0 +1,95 @@
+#include "Trace.h"
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Mutang;
+using namespace llvm;
+
+TEST(Trace, TraceScope_NothingWhenDisabled) {
+  Trace &trace = Trace::shared();
+  trace.setEnabled(false);
+
+  {
+    TraceScope scope("find tests", "discovery");
+  }
+
+  ASSERT_TRUE(trace.getSpans().empty());
+}
+
+TEST(Trace, TraceScope_RecordsSpan) {
+  Trace &trace = Trace::shared();
+  trace.setEnabled(true);
+
+  {
+    TraceScope scope("run test", "run", "Test.sum");
+  }
+
+  ASSERT_EQ(1U, trace.getSpans().size());
+  auto &span = trace.getSpans().front();
+  ASSERT_EQ("run test", span.name);
+  ASSERT_EQ("run", span.category);
+  ASSERT_EQ("Test.sum", span.detail);
+  ASSERT_LE(0, span.start);
+  ASSERT_LE(0, span.duration);
+
+  trace.setEnabled(false);
+}
+
+TEST(Trace, printSummary_IncludesForkedChildren) {
+  Trace &trace = Trace::shared();
+  trace.setEnabled(true);
+
+  trace.addSpan("compile mutant", "compile", 0, 3000);
+  trace.addSpan("compile mutant", "compile", 3000, 1000);
+
+  const pid_t pid = fork();
+  if (pid == 0) {
+    trace.addSpan("link objects", "jit", 0, 500);
+    _exit(0);
+  }
+  waitpid(pid, nullptr, 0);
+
+  /// The child's span is not in the parent's list
+  ASSERT_EQ(2U, trace.getSpans().size());
+
+  std::string summary;
+  raw_string_ostream out(summary);
+  trace.printSummary(out);
+  out.flush();
+
+  ASSERT_NE(std::string::npos, summary.find("compile mutant"));
+  ASSERT_NE(std::string::npos, summary.find("4.000"));
+  ASSERT_NE(std::string::npos, summary.find("link objects (forked)"));
+  ASSERT_NE(std::string::npos, summary.find("0.500"));
+
+  trace.setEnabled(false);
+}
+
+TEST(Trace, writeChromeTrace_EscapesDetails) {
+  Trace &trace = Trace::shared();
+  trace.setEnabled(true);
+
+  trace.addSpan("run mutant", "run", 10, 20, "Test.\"quoted\"\nname");
+
+  const std::string path = "/tmp/mutang_trace_test.json";
+  ASSERT_TRUE(trace.writeChromeTrace(path));
+
+  auto buffer = MemoryBuffer::getFile(path);
+  ASSERT_TRUE(bool(buffer));
+  std::string contents = (*buffer)->getBuffer().str();
+
+  ASSERT_NE(std::string::npos, contents.find("\"traceEvents\""));
+  ASSERT_NE(std::string::npos, contents.find("\"name\":\"run mutant\""));
+  ASSERT_NE(std::string::npos, contents.find("\"ph\":\"X\",\"ts\":10,\"dur\":20"));
+  ASSERT_NE(std::string::npos,
+            contents.find("\"detail\":\"Test.\\\"quoted\\\"\\nname\""));
+
+  unlink(path.c_str());
+  trace.setEnabled(false);
+}
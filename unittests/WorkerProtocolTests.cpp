@@ -0,0 +1,186 @@
+#include "WorkerProtocol.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace Mutang;
+
+TEST(WorkerProtocol, sendJob_RoundTrip) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  WorkerChannel coordinator(fds[0]);
+  WorkerChannel worker(fds[1]);
+
+  WorkerJob job = { 42, "Test.sum", "module_0_1_2", 1500, 10000 };
+  ASSERT_TRUE(coordinator.sendJob(job));
+
+  std::vector<std::string> message;
+  ASSERT_TRUE(worker.receive(message));
+
+  WorkerJob received;
+  ASSERT_TRUE(WorkerChannel::decodeJob(message, received));
+  ASSERT_EQ(42U, received.id);
+  ASSERT_EQ("Test.sum", received.testName);
+  ASSERT_EQ("module_0_1_2", received.mutationPoint);
+  ASSERT_EQ(1500, received.timeout);
+  ASSERT_EQ(10000U, received.iterationBudget);
+}
+
+TEST(WorkerProtocol, sendResult_KeepsOutputAsIs) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  WorkerChannel coordinator(fds[0]);
+  WorkerChannel worker(fds[1]);
+
+  ExecutionResult result;
+  result.Status = ExecutionStatus::Failed;
+  result.RunningTime = 123456;
+  result.stdoutOutput = "line\n\nanother line\n";
+  result.stderrOutput = std::string("binary\0output", 13);
+  result.Usage.UserTime = 1000;
+  result.Usage.MaxRSS = 20480;
+  result.Usage.ContextSwitches = 3;
+  ASSERT_TRUE(worker.sendResult(7, result));
+
+  std::vector<std::string> message;
+  ASSERT_TRUE(coordinator.receive(message));
+
+  uint64_t id = 0;
+  ExecutionResult received;
+  ASSERT_TRUE(WorkerChannel::decodeResult(message, id, received));
+  ASSERT_EQ(7U, id);
+  ASSERT_EQ(ExecutionStatus::Failed, received.Status);
+  ASSERT_EQ(123456, received.RunningTime);
+  ASSERT_EQ(result.stdoutOutput, received.stdoutOutput);
+  ASSERT_EQ(result.stderrOutput, received.stderrOutput);
+  ASSERT_EQ(1000, received.Usage.UserTime);
+  ASSERT_EQ(0, received.Usage.SystemTime);
+  ASSERT_EQ(20480, received.Usage.MaxRSS);
+  ASSERT_EQ(3, received.Usage.ContextSwitches);
+}
+
+TEST(WorkerProtocol, decode_RejectsOtherMessages) {
+  WorkerJob job;
+  uint64_t id = 0;
+  ExecutionResult result;
+
+  ASSERT_FALSE(WorkerChannel::decodeJob({ WorkerMessage::Done }, job));
+  ASSERT_FALSE(WorkerChannel::decodeResult({ WorkerMessage::Ready }, id, result));
+}
+
+TEST(WorkerProtocol, decode_RejectsMalformedNumbers) {
+  WorkerJob job;
+  uint64_t id = 0;
+  ExecutionResult result;
+
+  ASSERT_FALSE(WorkerChannel::decodeJob({ WorkerMessage::Job, "42x", "Test.sum",
+                                          "module_0_1_2", "1500", "10000" }, job));
+  ASSERT_FALSE(WorkerChannel::decodeJob({ WorkerMessage::Job, "42", "Test.sum",
+                                          "module_0_1_2", "", "10000" }, job));
+  ASSERT_FALSE(WorkerChannel::decodeJob({ WorkerMessage::Job, "42", "Test.sum",
+                                          "module_0_1_2", "1500", "-1" }, job));
+
+  std::vector<std::string> fields({ WorkerMessage::Result, "7", "1", "123456",
+                                    "", "", "0", "0", "0", "0", "0", "0" });
+  ASSERT_TRUE(WorkerChannel::decodeResult(fields, id, result));
+
+  auto malformed = fields;
+  malformed[8] = "lots";
+  ASSERT_FALSE(WorkerChannel::decodeResult(malformed, id, result));
+
+  /// Not one of the statuses
+  malformed = fields;
+  malformed[2] = "1000";
+  ASSERT_FALSE(WorkerChannel::decodeResult(malformed, id, result));
+}
+
+TEST(WorkerProtocol, receive_FailsOnceOtherSideIsGone) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  WorkerChannel coordinator(fds[0]);
+  close(fds[1]);
+
+  std::vector<std::string> message;
+  ASSERT_FALSE(coordinator.receive(message));
+  ASSERT_FALSE(coordinator.send({ WorkerMessage::Done }));
+}
+
+TEST(WorkerProtocol, receive_RefusesOversizedMessages) {
+  /// Field count, then the length of the first field, in network byte order
+  const char tooManyFields[] = { 0x00, 0x01, 0x00, 0x00 };
+  const char tooLongField[] = { 0x00, 0x00, 0x00, 0x01, 0x7f, 0xff, 0xff, 0xff };
+
+  for (auto &header : { std::string(tooManyFields, sizeof(tooManyFields)),
+                        std::string(tooLongField, sizeof(tooLongField)) }) {
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    WorkerChannel coordinator(fds[0]);
+    ASSERT_EQ((ssize_t)header.size(), write(fds[1], header.data(), header.size()));
+
+    std::vector<std::string> message;
+    ASSERT_FALSE(coordinator.receive(message));
+    close(fds[1]);
+  }
+}
+
+TEST(WorkerProtocol, sendResult_CutsOversizedOutput) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  WorkerChannel worker(fds[0]);
+  WorkerChannel coordinator(fds[1]);
+
+  ExecutionResult result;
+  result.Status = ExecutionStatus::Passed;
+  result.RunningTime = 1;
+  result.stdoutOutput = std::string(WorkerChannel::MaxFieldLength + 1, 'x');
+
+  std::thread sender([&]() { worker.sendResult(7, result); });
+
+  std::vector<std::string> message;
+  const bool received = coordinator.receive(message);
+  sender.join();
+  ASSERT_TRUE(received);
+
+  uint64_t id = 0;
+  ExecutionResult decoded;
+  ASSERT_TRUE(WorkerChannel::decodeResult(message, id, decoded));
+  ASSERT_EQ(WorkerChannel::MaxFieldLength, decoded.stdoutOutput.size());
+}
+
+TEST(WorkerProtocol, connectTo_ReachesListener) {
+  const std::string socketPath = "/tmp/mutang_worker_protocol_test.sock";
+
+  const int listener = WorkerChannel::listenOn(socketPath, 1);
+  ASSERT_NE(-1, listener);
+
+  WorkerChannel worker(WorkerChannel::connectTo(socketPath));
+  ASSERT_NE(-1, worker.getFileDescriptor());
+  ASSERT_TRUE(worker.send({ WorkerMessage::Ready }));
+
+  WorkerChannel coordinator(accept(listener, nullptr, nullptr));
+  std::vector<std::string> message;
+  ASSERT_TRUE(coordinator.receive(message));
+  ASSERT_EQ(1U, message.size());
+  ASSERT_EQ(WorkerMessage::Ready, message.front());
+
+  close(listener);
+  unlink(socketPath.c_str());
+}
+
+TEST(WorkerProtocol, listenOn_KeepsFileThatIsNotSocket) {
+  const std::string path = "/tmp/mutang_worker_protocol_test.file";
+
+  FILE *file = fopen(path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  fclose(file);
+
+  ASSERT_EQ(-1, WorkerChannel::listenOn(path, 1));
+  ASSERT_EQ(0, access(path.c_str(), F_OK));
+
+  unlink(path.c_str());
+}